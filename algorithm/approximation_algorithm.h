@@ -2,26 +2,102 @@
 #define APPROXIMATION_ALGORITHM_H
 
 #include <algorithm>
+#include <cmath>
+#include <optional>
 #include <ranges>
 #include <vector>
 
 #include "circle_algorithm.h"
+#include "least_squares_algorithm.h"
 #include "line_algorithm.h"
 
 namespace agl::approximation_algo{
 
+//Ленивое представление: count_point + 1 равноотстоящих точек отрезка, точки вычисляются при обходе
+template<c_point2d_decard Point>
+constexpr auto sample_segment(const Point &start, const Point &stop, size_t count_point){
+    const auto count = std::max(count_point, size_t(1));
+    const auto dx = (stop.x() - start.x()) / count;
+    const auto dy = (stop.y() - start.y()) / count;
+    return std::views::iota(size_t(), count + 1) | std::views::transform([start, dx, dy](size_t i){
+        return Point(start.x() + i * dx, start.y() + i * dy);
+    });
+}
+
+template<c_line_view Line>
+constexpr auto sample_segment(const Line &line, size_t count_point){
+    return sample_segment(line.view_begin.value, line.view_end.value, count_point);
+}
+
+//Ленивое представление: точки отрезка с шагом interval от начала (конец отрезка включается, только если попадает в шаг)
+template<c_point2d_decard Point, std::floating_point Type>
+constexpr auto sample_segment_step(const Point &start, const Point &stop, Type interval){
+    const auto dist = point_algo::distance(start, stop);
+    size_t count{};
+    if((interval > 0) && (dist > 0)){
+        count = static_cast<size_t>(std::floor(dist / interval + algorithm::epsilon<Type>)) + 1;
+    }
+    const auto dx = (dist > 0) ? (stop.x() - start.x()) / dist * interval : Type{};
+    const auto dy = (dist > 0) ? (stop.y() - start.y()) / dist * interval : Type{};
+    return std::views::iota(size_t(), count) | std::views::transform([start, dx, dy](size_t i){
+        return Point(start.x() + i * dx, start.y() + i * dy);
+    });
+}
+
+//Ленивое представление: count_point + 1 равноотстоящих точек дуги в заданном направлении обхода
+template<c_arc Arc>
+constexpr auto sample_arc(const Arc &arc, size_t count_point, algorithm::direct direct = algorithm::direct::RIGHT){
+    using Type = Arc::type_coefficients;
+    const auto start = (direct == algorithm::direct::RIGHT) ? arc.start() : arc.stop();
+    auto stop = (direct == algorithm::direct::RIGHT) ? arc.stop() : arc.start();
+    if(start > stop){
+        stop += algorithm::pi_in_2<Type>;
+    }
+    const auto count = std::max(count_point, size_t(1));
+    const auto da = (stop - start) / count;
+    return std::views::iota(size_t(), count + 1) | std::views::transform([center = arc.center(), radius = arc.radius(), start, da](size_t i){
+        return point_algo::new_point(center, start + i * da, radius);
+    });
+}
+
+//Ленивое представление: точки дуги с шагом interval по длине дуги от начала обхода
+template<c_arc Arc, std::floating_point Type>
+constexpr auto sample_arc_step(const Arc &arc, Type interval, algorithm::direct direct = algorithm::direct::RIGHT){
+    const auto start = (direct == algorithm::direct::RIGHT) ? arc.start() : arc.stop();
+    auto stop = (direct == algorithm::direct::RIGHT) ? arc.stop() : arc.start();
+    if(start > stop){
+        stop += algorithm::pi_in_2<Type>;
+    }
+    const auto length = (stop - start) * arc.radius();
+    size_t count{};
+    if((interval > 0) && (arc.radius() > 0)){
+        count = static_cast<size_t>(std::floor(length / interval + algorithm::epsilon<Type>)) + 1;
+    }
+    const auto da = (arc.radius() > 0) ? interval / arc.radius() : Type{};
+    return std::views::iota(size_t(), count) | std::views::transform([center = arc.center(), radius = arc.radius(), start, da](size_t i){
+        return point_algo::new_point(center, start + i * da, radius);
+    });
+}
+
+//Ленивое представление: count_point + 1 равноотстоящих точек окружности (первая и последняя совпадают)
+template<c_circle Circle>
+constexpr auto sample_circle(const Circle &circle, size_t count_point){
+    using Type = Circle::type_coefficients;
+    const auto count = std::max(count_point, size_t(1));
+    const auto da = algorithm::pi_in_2<Type> / count;
+    return std::views::iota(size_t(), count + 1) | std::views::transform([center = circle.center(), radius = circle.radius(), da](size_t i){
+        return point_algo::new_point(center, i * da, radius);
+    });
+}
+
 template<c_point2d_decard Point>
 constexpr std::vector<Point> splitting_evenly(const Point &start, const Point &stop, size_t count_point){
     if(count_point < 2){
         return {start, stop};
     }
-    const auto dx = (stop.x() - start.x()) / count_point;
-    const auto dy = (stop.y() - start.y()) / count_point;
     std::vector<Point> list;
-    const auto numbers = std::ranges::iota_view{size_t(), count_point + 1};
-    std::ranges::transform(numbers, std::back_inserter(list), [start, dx,dy](const auto &i){
-        return Point(start.x() + i * dx, start.y() + i * dy);
-    });
+    list.reserve(count_point + 1);
+    std::ranges::copy(sample_segment(start, stop, count_point), std::back_inserter(list));
     return list;
 }
 
@@ -33,36 +109,26 @@ constexpr auto splitting_evenly(const Line &line, size_t count_point) -> std::ve
 
 template<c_arc Arc>
 constexpr auto splitting_evenly(const Arc &arc, size_t count_point, algorithm::direct direct = algorithm::direct::RIGHT) -> std::vector<typename Arc::type_point>{
-    using Type = Arc::type_coefficients;
     auto mod_arc = (direct == algorithm::direct::RIGHT) ? arc :
                        Arc(arc.center(), arc.radius(), arc.stop(), arc.start());
     if(count_point < 2){
         return {point_algo::new_point(mod_arc.center(), mod_arc.start(), mod_arc.radius()),
                 point_algo::new_point(mod_arc.center(), mod_arc.stop(), mod_arc.radius())};
     }
-    const auto stop = (mod_arc.start() > mod_arc.stop()) ? (mod_arc.stop() + algorithm::pi_in_2<Type>) : mod_arc.stop();
-    const auto da = (stop - mod_arc.start()) / count_point;
     std::vector<typename Arc::type_point> list;
-
-    const auto numbers = std::ranges::iota_view{size_t(), count_point + 1};
-    std::ranges::transform(numbers, std::back_inserter(list), [mod_arc, da](const auto &i){
-        return point_algo::new_point(mod_arc.center(), mod_arc.start() + i * da, mod_arc.radius());
-    });
+    list.reserve(count_point + 1);
+    std::ranges::copy(sample_arc(arc, count_point, direct), std::back_inserter(list));
     return list;
 }
 
 template<c_circle Circle>
 constexpr auto splitting_evenly(const Circle &circle, size_t count_point) -> std::vector<typename Circle::type_point>{
-    using Type = Circle::type_coefficients;
     if(count_point < 2){
         return {point_algo::new_point(circle.center(), 0., circle.radius())};
     }
-    const auto da = algorithm::pi_in_2<Type> / count_point;
-    std::vector<typename Circle::type_point> list;  
-    const auto numbers = std::ranges::iota_view{size_t(), count_point + 1};
-    std::ranges::transform(numbers, std::back_inserter(list), [circle, da](const auto &i){
-        return point_algo::new_point(circle.center(), i * da, circle.radius());
-    });
+    std::vector<typename Circle::type_point> list;
+    list.reserve(count_point + 1);
+    std::ranges::copy(sample_circle(circle, count_point), std::back_inserter(list));
     return list;
 }
 
@@ -136,6 +202,124 @@ constexpr auto splitting_evenly(const Arc &arc, Type interval, Type &prior_remai
     return list;
 }
 
+//Многочлен степени Degree по МНК: y = c[0] + c[1] * (x - origin) + ... + c[Degree] * (x - origin)^Degree.
+//origin выбирается вблизи данных (например, время первого отсчёта), иначе степени x теряют точность
+template<size_t Degree, c_point2d_decard Point, std::floating_point Type = typename Point::type_coordinate>
+std::optional<vector<Type, Degree + 1>> fit_polynomial(const std::vector<Point> &points, Type origin = 0){
+    matrix_algo::least_squares_qr<Type, Degree + 1> solver;
+    for(const auto &point : points){
+        std::array<Type, Degree + 1> row;
+        const auto x = static_cast<Type>(point.x()) - origin;
+        row[0] = Type(1);
+        for(size_t i = 1; i <= Degree; ++i){
+            row[i] = row[i - 1] * x;
+        }
+        solver.add(row, static_cast<Type>(point.y()));
+    }
+    return solver.solve();
+}
+
+//Значение многочлена по схеме Горнера
+template<std::floating_point Type, size_t N>
+constexpr Type polynomial_value(const vector<Type, N> &coefficients, Type x, Type origin = 0){
+    Type temp{};
+    for(size_t i = N; i-- > 0;){
+        temp = temp * (x - origin) + coefficients.get(i);
+    }
+    return temp;
+}
+
+namespace {
+
+//Центральные моменты точек для подбора окружности: центр масс, Mxx, Myy, Mxy, Mxz, Myz, Mzz (z = x^2 + y^2)
+template<c_point2d_decard Point, std::floating_point Type = typename Point::type_coordinate>
+std::array<Type, 8> circle_moments(const std::vector<Point> &points){
+    Type mx{}, my{};
+    for(const auto &point : points){
+        mx += point.x();
+        my += point.y();
+    }
+    mx /= points.size();
+    my /= points.size();
+    std::array<Type, 8> temp{mx, my};
+    for(const auto &point : points){
+        const auto x = static_cast<Type>(point.x()) - mx;
+        const auto y = static_cast<Type>(point.y()) - my;
+        const auto z = x * x + y * y;
+        temp[2] += x * x;
+        temp[3] += y * y;
+        temp[4] += x * y;
+        temp[5] += x * z;
+        temp[6] += y * z;
+        temp[7] += z * z;
+    }
+    for(size_t i = 2; i < temp.size(); ++i){
+        temp[i] /= points.size();
+    }
+    return temp;
+}
+
+}
+
+//Окружность по методу Косы (алгебраическое расстояние x^2 + y^2 + D x + E y + F). Быстрый, но смещает радиус
+//в меньшую сторону на коротких дугах. Пустое значение - точек меньше трёх или они на одной прямой
+template<c_circle Circle, c_point2d_decard Point>
+std::optional<Circle> fit_circle_kasa(const std::vector<Point> &points){
+    using Type = Circle::type_coefficients;
+    if(points.size() < 3){
+        return std::nullopt;
+    }
+    const auto [mx, my, mxx, myy, mxy, mxz, myz, mzz] = circle_moments(points);
+    //В центрированных координатах: 2 * M * c = [Mxz, Myz], радиус^2 = |c|^2 + Mz
+    const auto det = mxx * myy - mxy * mxy;
+    if(std::abs(det) <= std::numeric_limits<Type>::epsilon() * (mxx + myy) * (mxx + myy)){
+        return std::nullopt;
+    }
+    const auto cx = (mxz * myy - myz * mxy) / (2 * det);
+    const auto cy = (myz * mxx - mxz * mxy) / (2 * det);
+    return Circle(typename Circle::type_point(cx + mx, cy + my), std::sqrt(cx * cx + cy * cy + mxx + myy));
+}
+
+//Окружность по методу Таубина (градиентно взвешенное алгебраическое расстояние): почти несмещённый радиус
+//на дугах. Наименьший корень характеристического многочлена ищется методом Ньютона (Н. Чернов)
+template<c_circle Circle, c_point2d_decard Point>
+std::optional<Circle> fit_circle_taubin(const std::vector<Point> &points){
+    using Type = Circle::type_coefficients;
+    if(points.size() < 3){
+        return std::nullopt;
+    }
+    const auto [mx, my, mxx, myy, mxy, mxz, myz, mzz] = circle_moments(points);
+    const auto mz = mxx + myy;
+    const auto cov_xy = mxx * myy - mxy * mxy;
+    const auto var_z = mzz - mz * mz;
+    const auto a3 = 4 * mz;
+    const auto a2 = -3 * mz * mz - mzz;
+    const auto a1 = var_z * mz + 4 * cov_xy * mz - mxz * mxz - myz * myz;
+    const auto a0 = mxz * (mxz * myy - myz * mxy) + myz * (myz * mxx - mxz * mxy) - var_z * cov_xy;
+    Type x{};
+    Type y = a0;
+    for(size_t i = 0; i < 100; ++i){
+        const auto dy = a1 + x * (2 * a2 + 3 * a3 * x);
+        const auto x_new = x - y / dy;
+        if((x_new == x) || !std::isfinite(x_new)){
+            break;
+        }
+        const auto y_new = a0 + x_new * (a1 + x_new * (a2 + x_new * a3));
+        if(std::abs(y_new) >= std::abs(y)){
+            break;
+        }
+        x = x_new;
+        y = y_new;
+    }
+    const auto det = x * x - x * mz + cov_xy;
+    if(std::abs(det) <= std::numeric_limits<Type>::epsilon() * mz * mz){
+        return std::nullopt;
+    }
+    const auto cx = (mxz * (myy - x) - myz * mxy) / (2 * det);
+    const auto cy = (myz * (mxx - x) - mxz * mxy) / (2 * det);
+    return Circle(typename Circle::type_point(cx + mx, cy + my), std::sqrt(cx * cx + cy * cy + mz));
+}
+
 }
 
 #endif // APPROXIMATION_ALGORITHM_H
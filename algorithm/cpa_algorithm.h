@@ -0,0 +1,174 @@
+#ifndef CPA_ALGORITHM_H
+#define CPA_ALGORITHM_H
+
+#include <algorithm>
+#include <future>
+#include <initializer_list>
+#include <tuple>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "math_algorithm.h"
+#include "../system/system_concept.h"
+
+namespace agl::cpa_algo{
+
+//Прямолинейное равномерное движение: положение (x, y, h) на момент time и скорость по осям
+template<std::floating_point Type>
+struct linear_motion{
+    Type x{};
+    Type y{};
+    Type h{};
+    Type time{};
+    Type vx{};
+    Type vy{};
+    Type vh{};
+
+    constexpr Type x_at(Type t) const{
+        return x + vx * (t - time);
+    }
+    constexpr Type y_at(Type t) const{
+        return y + vy * (t - time);
+    }
+    constexpr Type h_at(Type t) const{
+        return h + vh * (t - time);
+    }
+};
+
+//Результат поиска точки наибольшего сближения: момент (TCPA) и расстояние (CPA)
+template<std::floating_point Type>
+struct cpa_result{
+    Type time;
+    Type distance;
+};
+
+template<std::floating_point Type>
+struct cpa_pair{
+    size_t first;
+    size_t second;
+    cpa_result<Type> cpa;
+};
+
+//Движение по двум отметкам с временем
+template<c_point4d_decard Point>
+constexpr auto make_motion(const Point &point1, const Point &point2) -> linear_motion<typename Point::type_coordinate>{
+    using Type = Point::type_coordinate;
+    const auto dt = point2.time() - point1.time();
+    if(algorithm::compare(dt, Type{})){
+        return {point2.x(), point2.y(), point2.h(), point2.time()};
+    }
+    return {point2.x(), point2.y(), point2.h(), point2.time(),
+            (point2.x() - point1.x()) / dt, (point2.y() - point1.y()) / dt, (point2.h() - point1.h()) / dt};
+}
+
+//Функция возвращает момент и расстояние наибольшего сближения двух движений на интервале [begin, end]
+template<std::floating_point Type>
+constexpr cpa_result<Type> cpa(const linear_motion<Type> &motion1, const linear_motion<Type> &motion2, Type begin, Type end){
+    const auto dx = motion2.x_at(begin) - motion1.x_at(begin);
+    const auto dy = motion2.y_at(begin) - motion1.y_at(begin);
+    const auto dh = motion2.h_at(begin) - motion1.h_at(begin);
+    const auto vx = motion2.vx - motion1.vx;
+    const auto vy = motion2.vy - motion1.vy;
+    const auto vh = motion2.vh - motion1.vh;
+    const auto v2 = vx * vx + vy * vy + vh * vh;
+    auto t = (v2 > 0) ? -(dx * vx + dy * vy + dh * vh) / v2 : Type{};
+    t = std::clamp(t, Type{}, std::max(end - begin, Type{}));
+    const auto ex = dx + vx * t;
+    const auto ey = dy + vy * t;
+    const auto eh = dh + vh * t;
+    return {begin + t, std::sqrt(ex * ex + ey * ey + eh * eh)};
+}
+
+template<c_point4d_decard Point>
+constexpr auto cpa(const Point &start1, const Point &stop1, const Point &start2, const Point &stop2,
+                   typename Point::type_coordinate begin, typename Point::type_coordinate end){
+    return cpa(make_motion(start1, stop1), make_motion(start2, stop2), begin, end);
+}
+
+namespace {
+
+template<std::floating_point Type>
+struct motion_box{
+    Type min_x;
+    Type max_x;
+    Type min_y;
+    Type max_y;
+    Type min_h;
+    Type max_h;
+    size_t index;
+};
+
+//Габарит траектории на интервале [begin, end], расширенный на половину порога
+template<std::floating_point Type>
+constexpr motion_box<Type> make_box(const linear_motion<Type> &motion, Type begin, Type end, Type margin, size_t index){
+    const auto [min_x, max_x] = std::minmax({motion.x_at(begin), motion.x_at(end)});
+    const auto [min_y, max_y] = std::minmax({motion.y_at(begin), motion.y_at(end)});
+    const auto [min_h, max_h] = std::minmax({motion.h_at(begin), motion.h_at(end)});
+    return {min_x - margin, max_x + margin, min_y - margin, max_y + margin, min_h - margin, max_h + margin, index};
+}
+
+}
+
+//Функция находит все пары движений, сближающиеся на интервале [begin, end] ближе порога threshold.
+//Кандидаты отбираются проходом по габаритам траекторий, отсортированным по x; проход делится между потоками
+template<std::floating_point Type>
+std::vector<cpa_pair<Type>> conflicts(std::span<const linear_motion<Type>> motions, Type threshold, Type begin, Type end,
+                                      size_t threads = 1){
+    std::vector<motion_box<Type>> boxes;
+    boxes.reserve(motions.size());
+    for(size_t i = 0; i < motions.size(); ++i){
+        boxes.push_back(make_box(motions[i], begin, end, threshold / 2, i));
+    }
+    std::ranges::sort(boxes, std::less{}, &motion_box<Type>::min_x);
+
+    auto sweep = [&boxes, &motions, threshold, begin, end](size_t first, size_t step){
+        std::vector<cpa_pair<Type>> pairs;
+        for(size_t i = first; i < boxes.size(); i += step){
+            const auto &box1 = boxes[i];
+            for(size_t j = i + 1; (j < boxes.size()) && (boxes[j].min_x <= box1.max_x); ++j){
+                const auto &box2 = boxes[j];
+                if((box2.min_y > box1.max_y) || (box1.min_y > box2.max_y) || (box2.min_h > box1.max_h) || (box1.min_h > box2.max_h)){
+                    continue;
+                }
+                const auto result = cpa(motions[box1.index], motions[box2.index], begin, end);
+                if(result.distance < threshold){
+                    pairs.push_back({std::min(box1.index, box2.index), std::max(box1.index, box2.index), result});
+                }
+            }
+        }
+        return pairs;
+    };
+
+    std::vector<cpa_pair<Type>> pairs;
+    threads = std::clamp<size_t>(threads, 1, std::max<size_t>(boxes.size(), 1));
+    if(threads == 1){
+        pairs = sweep(0, 1);
+    }
+    else{
+        //Чередование индексов выравнивает нагрузку: плотные участки оси x достаются всем потокам
+        std::vector<std::future<std::vector<cpa_pair<Type>>>> tasks;
+        tasks.reserve(threads);
+        for(size_t i = 0; i < threads; ++i){
+            tasks.push_back(std::async(std::launch::async, sweep, i, threads));
+        }
+        for(auto &task : tasks){
+            auto part = task.get();
+            pairs.insert(pairs.end(), part.begin(), part.end());
+        }
+    }
+    std::ranges::sort(pairs, [](const auto &pair1, const auto &pair2){
+        return std::tie(pair1.first, pair1.second) < std::tie(pair2.first, pair2.second);
+    });
+    return pairs;
+}
+
+template<std::floating_point Type>
+std::vector<cpa_pair<Type>> conflicts(const std::vector<linear_motion<Type>> &motions, Type threshold, Type begin, Type end,
+                                      size_t threads = 1){
+    return conflicts(std::span<const linear_motion<Type>>(motions), threshold, begin, end, threads);
+}
+
+}
+
+#endif // CPA_ALGORITHM_H
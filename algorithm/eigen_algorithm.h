@@ -0,0 +1,395 @@
+#ifndef EIGEN_ALGORITHM_H
+#define EIGEN_ALGORITHM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../structs/matrix.h"
+#include "../structs/vector.h"
+#include "../system/system_concept.h"
+
+namespace agl {
+
+//Собственные числа симметричной матрицы по убыванию и собственные векторы (ортонормированные столбцы vectors)
+template<std::floating_point Type, size_t N>
+struct eigen_decomposition{
+    vector<Type, N> values;
+    matrix<Type, N, N> vectors;
+};
+
+//Эллипс ошибок: полуоси и направление большой полуоси (от оси y по часовой стрелке, [0, pi))
+template<std::floating_point Type>
+struct error_ellipse{
+    Type semi_major;
+    Type semi_minor;
+    Type angle;
+};
+
+namespace matrix_algo{
+
+namespace {
+
+//Собственные числа и первый собственный вектор (cos, sin угла от оси x против часовой стрелки)
+//симметричной 2x2 матрицы [[a, b], [b, d]]. Половинный угол считается без тригонометрии,
+//ветвь выбирается так, чтобы не вычитать близкие числа
+template<std::floating_point Type>
+constexpr std::array<Type, 4> eigen_2x2(Type a, Type b, Type d){
+    const auto mean = (a + d) / 2;
+    const auto half = (a - d) / 2;
+    const auto radius = std::sqrt(half * half + b * b);
+    if(radius == Type{}){
+        return {mean, mean, Type(1), Type{}};
+    }
+    const auto cos_2 = half / radius;
+    const auto sin_2 = b / radius;
+    Type c, s;
+    if(cos_2 >= 0){
+        c = std::sqrt((1 + cos_2) / 2);
+        s = sin_2 / (2 * c);
+    }
+    else{
+        s = std::copysign(std::sqrt((1 - cos_2) / 2), sin_2);
+        c = sin_2 / (2 * s);
+    }
+    return {mean + radius, mean - radius, c, s};
+}
+
+//Единичный вектор ядра (A - value * I) для симметричной 3x3 матрицы a (по строкам):
+//наибольшее по модулю векторное произведение строк. Для кратного собственного числа результат - любой вектор ядра
+template<std::floating_point Type>
+constexpr std::array<Type, 3> eigen_vector_3x3(const std::array<Type, 9> &a, Type value){
+    const std::array<Type, 3> r0{a[0] - value, a[1], a[2]};
+    const std::array<Type, 3> r1{a[3], a[4] - value, a[5]};
+    const std::array<Type, 3> r2{a[6], a[7], a[8] - value};
+    auto cross = [](const std::array<Type, 3> &u, const std::array<Type, 3> &v){
+        return std::array<Type, 3>{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+    };
+    const std::array<std::array<Type, 3>, 3> candidates{cross(r0, r1), cross(r0, r2), cross(r1, r2)};
+    size_t best = 0;
+    Type best_norm{};
+    for(size_t i = 0; i < 3; ++i){
+        const auto norm = candidates[i][0] * candidates[i][0] + candidates[i][1] * candidates[i][1]
+                          + candidates[i][2] * candidates[i][2];
+        if(norm > best_norm){
+            best_norm = norm;
+            best = i;
+        }
+    }
+    if(best_norm == Type{}){
+        return {Type(1), Type{}, Type{}};
+    }
+    const auto norm = std::sqrt(best_norm);
+    return {candidates[best][0] / norm, candidates[best][1] / norm, candidates[best][2] / norm};
+}
+
+//Разложение симметричной 3x3 матрицы (по строкам): собственные числа тригонометрическим методом Смита,
+//вектор наиболее отделённого числа - через векторные произведения, оставшиеся два - решением 2x2 задачи
+//в ортогональном дополнении (устойчиво для кратных чисел). Результат: 3 числа по убыванию и 3 вектора-столбца
+template<std::floating_point Type>
+constexpr std::array<Type, 12> eigen_3x3(std::array<Type, 9> a){
+    //Масштабирование защищает от переполнения квадратов
+    Type scale{};
+    for(const auto value : a){
+        scale = std::max(scale, std::abs(value));
+    }
+    if(scale == Type{}){
+        return {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1};
+    }
+    for(auto &value : a){
+        value /= scale;
+    }
+    const auto off = a[1] * a[1] + a[2] * a[2] + a[5] * a[5];
+    const auto q = (a[0] + a[4] + a[8]) / 3;
+    const auto p2 = (a[0] - q) * (a[0] - q) + (a[4] - q) * (a[4] - q) + (a[8] - q) * (a[8] - q) + 2 * off;
+    const auto p = std::sqrt(p2 / 6);
+    std::array<Type, 3> values{q, q, q};
+    if(p > Type{}){
+        std::array<Type, 9> b = a;
+        for(size_t i = 0; i < 3; ++i){
+            b[i * 4] -= q;
+        }
+        for(auto &value : b){
+            value /= p;
+        }
+        const auto r = std::clamp(determinant(b) / 2, Type(-1), Type(1));
+        const auto [sin_phi, cos_phi] = algorithm::sincos<algorithm::function_angle<Type>>(std::acos(r) / 3);
+        //cos(phi + 2pi/3) = -cos(phi) / 2 - sqrt(3) * sin(phi) / 2
+        values[0] = q + 2 * p * cos_phi;
+        values[2] = q - p * (cos_phi + std::sqrt(Type(3)) * sin_phi);
+        values[1] = 3 * q - values[0] - values[2];
+    }
+
+    //Первым ищется вектор числа, наиболее удалённого от остальных
+    const auto first = (values[0] - values[1] >= values[1] - values[2]) ? size_t(0) : size_t(2);
+    const auto v = eigen_vector_3x3(a, values[first]);
+    //Ортонормированный базис u, w дополнения к v
+    std::array<Type, 3> u = (std::abs(v[0]) > std::abs(v[1])) ? std::array<Type, 3>{-v[2], Type{}, v[0]}
+                                                               : std::array<Type, 3>{Type{}, v[2], -v[1]};
+    const auto u_norm = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+    for(auto &value : u){
+        value /= u_norm;
+    }
+    const std::array<Type, 3> w{v[1] * u[2] - v[2] * u[1], v[2] * u[0] - v[0] * u[2], v[0] * u[1] - v[1] * u[0]};
+    //Проекция матрицы на плоскость (u, w)
+    const auto au = mul<Type, 3>(a, u);
+    const auto aw = mul<Type, 3>(a, w);
+    const auto [l1, l2, c, s] = eigen_2x2(u[0] * au[0] + u[1] * au[1] + u[2] * au[2],
+                                          u[0] * aw[0] + u[1] * aw[1] + u[2] * aw[2],
+                                          w[0] * aw[0] + w[1] * aw[1] + w[2] * aw[2]);
+    const std::array<Type, 3> v1{c * u[0] + s * w[0], c * u[1] + s * w[1], c * u[2] + s * w[2]};
+    const std::array<Type, 3> v2{-s * u[0] + c * w[0], -s * u[1] + c * w[1], -s * u[2] + c * w[2]};
+
+    std::array<std::pair<Type, std::array<Type, 3>>, 3> items{std::pair{values[first], v}, std::pair{l1, v1}, std::pair{l2, v2}};
+    std::ranges::sort(items, std::greater{}, &std::pair<Type, std::array<Type, 3>>::first);
+    std::array<Type, 12> temp;
+    for(size_t j = 0; j < 3; ++j){
+        temp[j] = items[j].first * scale;
+        for(size_t i = 0; i < 3; ++i){
+            temp[3 + i * 3 + j] = items[j].second[i];
+        }
+    }
+    return temp;
+}
+
+}
+
+//Разложение симметричной матрицы циклическим методом Якоби. Используется только верхний треугольник.
+//Сходимость квадратичная, обычно 6-10 проходов для double
+template<std::floating_point Type, size_t N>
+eigen_decomposition<Type, N> jacobi_eigen(const matrix<Type, N, N> &m, size_t max_sweeps = 50){
+    std::array<Type, N * N> a;
+    std::array<Type, N * N> v{};
+    for(size_t i = 0; i < N; ++i){
+        for(size_t j = 0; j < N; ++j){
+            a[i * N + j] = m.value(std::min(i, j), std::max(i, j));
+        }
+        v[i * N + i] = Type(1);
+    }
+    for(size_t sweep = 0; sweep < max_sweeps; ++sweep){
+        Type off{};
+        Type diagonal{};
+        for(size_t i = 0; i < N; ++i){
+            diagonal += a[i * N + i] * a[i * N + i];
+            for(size_t j = i + 1; j < N; ++j){
+                off += a[i * N + j] * a[i * N + j];
+            }
+        }
+        if(off <= std::numeric_limits<Type>::epsilon() * std::numeric_limits<Type>::epsilon() * diagonal){
+            break;
+        }
+        for(size_t p = 0; p < N; ++p){
+            for(size_t q = p + 1; q < N; ++q){
+                const auto apq = a[p * N + q];
+                if(apq == Type{}){
+                    continue;
+                }
+                //Поворот, обнуляющий a[p][q]: t = tg угла, выбирается меньший по модулю корень
+                const auto theta = (a[q * N + q] - a[p * N + p]) / (2 * apq);
+                const auto t = std::copysign(Type(1), theta) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                const auto c = 1 / std::sqrt(t * t + 1);
+                const auto s = t * c;
+                for(size_t k = 0; k < N; ++k){
+                    const auto akp = a[k * N + p];
+                    const auto akq = a[k * N + q];
+                    a[k * N + p] = c * akp - s * akq;
+                    a[k * N + q] = s * akp + c * akq;
+                }
+                for(size_t k = 0; k < N; ++k){
+                    const auto apk = a[p * N + k];
+                    const auto aqk = a[q * N + k];
+                    a[p * N + k] = c * apk - s * aqk;
+                    a[q * N + k] = s * apk + c * aqk;
+                }
+                for(size_t k = 0; k < N; ++k){
+                    const auto vkp = v[k * N + p];
+                    const auto vkq = v[k * N + q];
+                    v[k * N + p] = c * vkp - s * vkq;
+                    v[k * N + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    std::array<size_t, N> order;
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::ranges::sort(order, [&a](size_t i, size_t j){
+        return a[i * N + i] > a[j * N + j];
+    });
+    eigen_decomposition<Type, N> temp;
+    for(size_t j = 0; j < N; ++j){
+        temp.values.begin()[j] = a[order[j] * N + order[j]];
+        for(size_t i = 0; i < N; ++i){
+            temp.vectors.value(i, j) = v[i * N + order[j]];
+        }
+    }
+    return temp;
+}
+
+//Разложение симметричной матрицы: для 2x2 и 3x3 - в замкнутой форме, для больших - методом Якоби
+template<std::floating_point Type, size_t N>
+eigen_decomposition<Type, N> eigen_symmetric(const matrix<Type, N, N> &m){
+    eigen_decomposition<Type, N> temp;
+    if constexpr(N == 1){
+        temp.values = {m.value(0, 0)};
+        temp.vectors.value(0, 0) = Type(1);
+    }
+    else if constexpr(N == 2){
+        const auto [l1, l2, c, s] = eigen_2x2(m.value(0, 0), m.value(0, 1), m.value(1, 1));
+        temp.values = {l1, l2};
+        temp.vectors = matrix<Type, 2, 2>{c, -s,
+                                          s, c};
+    }
+    else if constexpr(N == 3){
+        const auto r = eigen_3x3(std::array{m.value(0, 0), m.value(0, 1), m.value(0, 2),
+                                            m.value(0, 1), m.value(1, 1), m.value(1, 2),
+                                            m.value(0, 2), m.value(1, 2), m.value(2, 2)});
+        temp.values = {r[0], r[1], r[2]};
+        temp.vectors = matrix<Type, 3, 3>{r[3], r[4], r[5], r[6], r[7], r[8], r[9], r[10], r[11]};
+    }
+    else{
+        temp = jacobi_eigen(m);
+    }
+    return temp;
+}
+
+//Собственные числа по убыванию без векторов
+template<std::floating_point Type, size_t N>
+vector<Type, N> eigen_values(const matrix<Type, N, N> &m){
+    if constexpr(N == 2){
+        const auto e = eigen_2x2(m.value(0, 0), m.value(0, 1), m.value(1, 1));
+        return {e[0], e[1]};
+    }
+    else{
+        return eigen_symmetric(m).values;
+    }
+}
+
+namespace {
+
+template<std::floating_point Type>
+constexpr error_ellipse<Type> ellipse_2x2(Type xx, Type xy, Type yy, Type sigma){
+    const auto [l1, l2, c, s] = eigen_2x2(xx, xy, yy);
+    //Направление вектора (c, s) от оси y по часовой стрелке; c >= 0 или s > 0, поэтому угол в [0, pi]
+    auto direction = std::atan2(c, s);
+    direction = (direction >= algorithm::pi<Type>) ? direction - algorithm::pi<Type> : direction;
+    return {sigma * std::sqrt(std::max(l1, Type{})), sigma * std::sqrt(std::max(l2, Type{})), direction};
+}
+
+}
+
+//Эллипс ошибок ковариационной матрицы 2x2 (x, y): полуоси sigma * sqrt(собственных чисел)
+template<std::floating_point Type>
+error_ellipse<Type> covariance_ellipse(const matrix<Type, 2, 2> &covariance, Type sigma = 1){
+    return ellipse_2x2(covariance.value(0, 0), covariance.value(0, 1), covariance.value(1, 1), sigma);
+}
+
+//Пакетный расчёт эллипсов ошибок по раздельным элементам ковариаций
+template<std::floating_point Type>
+void covariance_ellipse(std::span<const Type> xx, std::span<const Type> xy, std::span<const Type> yy,
+                        std::span<error_ellipse<Type>> result, Type sigma = 1){
+    if((xx.size() != xy.size()) || (xx.size() != yy.size()) || (result.size() < xx.size())){
+        throw std::logic_error("covariance_ellipse: size mismatch");
+    }
+    for(size_t i = 0; i < xx.size(); ++i){
+        result[i] = ellipse_2x2(xx[i], xy[i], yy[i], sigma);
+    }
+}
+
+template<std::floating_point Type>
+void covariance_ellipse(std::span<const matrix<Type, 2, 2>> covariances, std::span<error_ellipse<Type>> result, Type sigma = 1){
+    if(result.size() < covariances.size()){
+        throw std::logic_error("covariance_ellipse: size mismatch");
+    }
+    for(size_t i = 0; i < covariances.size(); ++i){
+        result[i] = covariance_ellipse(covariances[i], sigma);
+    }
+}
+
+//Пакетное разложение набора симметричных матриц одного размера
+template<std::floating_point Type, size_t N>
+void eigen_symmetric(std::span<const matrix<Type, N, N>> matrices, std::span<eigen_decomposition<Type, N>> result){
+    if(result.size() < matrices.size()){
+        throw std::logic_error("eigen_symmetric: size mismatch");
+    }
+    for(size_t i = 0; i < matrices.size(); ++i){
+        result[i] = eigen_symmetric(matrices[i]);
+    }
+}
+
+template<std::floating_point Type, size_t N>
+std::vector<eigen_decomposition<Type, N>> eigen_symmetric(const std::vector<matrix<Type, N, N>> &matrices){
+    std::vector<eigen_decomposition<Type, N>> temp(matrices.size());
+    eigen_symmetric(std::span<const matrix<Type, N, N>>(matrices), std::span(temp));
+    return temp;
+}
+
+//Выборочная ковариационная матрица точек (делитель n - 1) и центр масс
+template<typename Point> requires c_point2d_decard<Point> || c_point3d_decard<Point>
+auto covariance(const std::vector<Point> &points){
+    using Type = Point::type_coordinate;
+    constexpr size_t N = c_point3d_decard<Point> ? 3 : 2;
+    if(points.size() < 2){
+        throw std::logic_error("covariance: not enough points");
+    }
+    auto coordinates = [](const Point &point){
+        if constexpr(N == 3){
+            return std::array<Type, 3>{point.x(), point.y(), point.h()};
+        }
+        else{
+            return std::array<Type, 2>{point.x(), point.y()};
+        }
+    };
+    std::array<Type, N> mean{};
+    for(const auto &point : points){
+        const auto c = coordinates(point);
+        for(size_t i = 0; i < N; ++i){
+            mean[i] += c[i];
+        }
+    }
+    for(auto &value : mean){
+        value /= points.size();
+    }
+    matrix<Type, N, N> temp;
+    for(const auto &point : points){
+        const auto c = coordinates(point);
+        for(size_t i = 0; i < N; ++i){
+            for(size_t j = i; j < N; ++j){
+                temp.value(i, j) += (c[i] - mean[i]) * (c[j] - mean[j]);
+            }
+        }
+    }
+    for(size_t i = 0; i < N; ++i){
+        for(size_t j = i; j < N; ++j){
+            temp.value(i, j) /= points.size() - 1;
+            temp.value(j, i) = temp.value(i, j);
+        }
+    }
+    Point center;
+    if constexpr(N == 3){
+        center = Point(mean[0], mean[1], mean[2]);
+    }
+    else{
+        center = Point(mean[0], mean[1]);
+    }
+    return std::pair{center, temp};
+}
+
+//Главные оси облака точек: центр масс и разложение ковариационной матрицы
+//(первый столбец vectors - направление наибольшего разброса)
+template<typename Point> requires c_point2d_decard<Point> || c_point3d_decard<Point>
+auto principal_axes(const std::vector<Point> &points){
+    const auto [center, m] = covariance(points);
+    return std::pair{center, eigen_symmetric(m)};
+}
+
+}
+
+}
+
+#endif // EIGEN_ALGORITHM_H
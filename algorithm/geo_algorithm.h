@@ -4,52 +4,68 @@
 #include "../system/system_concept.h"
 #include "../algorithm/point_algorithm.h"
 #include "math_algorithm.h"
+#include "../structs/ellipsoid_impl.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 namespace agl::geo_algo {
 
-namespace {
-
-template <std::floating_point Type> inline constexpr Type semiminor_axis;
-template<> inline constexpr double semiminor_axis<double> = 6356751.362;
-template<> inline constexpr float semiminor_axis<float> = 6356751.362;
-
-template <std::floating_point Type> inline constexpr Type semimajor_axis;
-template<> inline constexpr double semimajor_axis<double> = 6378136.;
-template<> inline constexpr float semimajor_axis<float> = 6378136;
-
-template<std::floating_point Type>
-constexpr Type eccentricity2_1(){
-    return (semiminor_axis<Type> * semiminor_axis<Type> - semimajor_axis<Type> * semimajor_axis<Type>)
-    / (semiminor_axis<Type> * semiminor_axis<Type>);
+//sin и cos широты точки: из кэша point_geo2d_prepared или вычислением
+template<typename ClassFunc, c_point2d_geo PointGeo>
+constexpr auto latitude_sincos(const PointGeo &point) -> std::pair<typename PointGeo::type_coordinate, typename PointGeo::type_coordinate>{
+    if constexpr(requires{ point.sin_latitude(); point.cos_latitude(); }){
+        return {point.sin_latitude(), point.cos_latitude()};
+    }
+    else{
+        return algorithm::sincos<ClassFunc>(static_cast<typename PointGeo::type_coordinate>(point.latitude()));
+    }
 }
 
-template<std::floating_point Type>
-constexpr Type eccentricity2_2(){
-    return (semimajor_axis<Type> * semimajor_axis<Type> - semiminor_axis<Type> * semiminor_axis<Type>)
-    / (semiminor_axis<Type> * semiminor_axis<Type>);
+//sin и cos приведённой широты точки на эллипсоиде Ellipsoid
+template<typename ClassFunc, c_ellipsoid Ellipsoid, c_point2d_geo PointGeo>
+constexpr auto reduced_latitude(const PointGeo &point) -> std::pair<typename PointGeo::type_coordinate, typename PointGeo::type_coordinate>{
+    if constexpr(requires{ point.sin_u(); point.cos_u(); requires std::is_same_v<typename PointGeo::ellipsoid, Ellipsoid>; }){
+        return {point.sin_u(), point.cos_u()};
+    }
+    else{
+        constexpr auto _e2 = Ellipsoid::eccentricity2_1;
+        const auto [_sinLat, _cosLat] = latitude_sincos<ClassFunc>(point);
+        const auto _os = sqrt(1.0 - _e2 * _sinLat * _sinLat);
+        return {_sinLat * Ellipsoid::axis_ratio / _os, _cosLat / _os};
+    }
 }
 
-}
+//Слагаемые прямой задачи, зависящие только от начальной точки и азимута
+template<std::floating_point Type>
+struct direct_terms{
+    Type longitude;
+    Type sin_u1;
+    Type cos_u1;
+    Type sin_omnibearing;
+    Type cos_omnibearing;
+    Type sin_a0;
+    Type cos2_a0;
+    Type sin_2q1;
+    Type cos_2q1;
+    Type k_a;
+    Type k_ba;
+    Type k_c;
+};
 
 template<std::floating_point Type, std::floating_point TypeAngle, c_point2d_geo PointGeo,
-         c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>>
-constexpr PointGeo common_survey_comp(Type range, TypeAngle omnibearing, const PointGeo &reference_point){
-    if(algorithm::compare(range, 0.) && (omnibearing == TypeAngle())){
-        return reference_point;
-    }
+         c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>, c_ellipsoid Ellipsoid = pz90<Type>>
+constexpr direct_terms<Type> prepare_direct(TypeAngle omnibearing, const PointGeo &reference_point){
+    const auto [_sinU1, _cosU1] = reduced_latitude<ClassFunc, Ellipsoid>(reference_point);
+    const auto [_sinOmn, _cosOmn] = algorithm::sincos<ClassFunc>(static_cast<Type>(omnibearing));
 
-    const auto _e2 = eccentricity2_1<Type>();
-    const auto _sinLat = ClassFunc::sin(reference_point.latitude());
-    const auto _os = sqrt(1.0 - _e2 * _sinLat * _sinLat);
-    const auto _sqrtE2 = sqrt(1.0 - _e2);
-    const auto _sinU1 = _sinLat * _sqrtE2 / _os;
-    const auto _cosU1 = ClassFunc::cos(reference_point.latitude()) / _os;
-    const auto _cosOmn = ClassFunc::cos(omnibearing);
-    const auto _sinOmn = ClassFunc::sin(omnibearing);
-
-    const auto _a0 = asin(_cosU1 * _sinOmn);
+    const auto _a0 = ClassFunc::asin(_cosU1 * _sinOmn);
+    const auto [_sinA0, _cosA0] = algorithm::sincos<ClassFunc>(_a0);
     auto _sin2q1 = 0.0;
     auto _cos2q1 = 1.0;
     if(!algorithm::compare(_sinU1, 0.0)){
@@ -58,33 +74,46 @@ constexpr PointGeo common_survey_comp(Type range, TypeAngle omnibearing, const P
         _cos2q1 = (_ctgQ1 * _ctgQ1 - 1.0) / (_ctgQ1 * _ctgQ1 + 1.0);
     }
 
-    const auto _cos2a0 = ClassFunc::cos(_a0) * ClassFunc::cos(_a0);
-    const auto _k2 = eccentricity2_2<Type>() * _cos2a0;
+    const auto _cos2a0 = _cosA0 * _cosA0;
+    const auto _k2 = Ellipsoid::eccentricity2_2 * _cos2a0;
 
     const auto _k2_2 = _k2 * _k2;
     const auto _kA = 1.0 + _k2 / 4.0 - 3.0 * _k2_2 / 64.0;
     const auto _kBA = (_k2 / 4.0 - _k2_2 / 16.0) / _kA;
     const auto _kC = _k2_2 / 128.0;
+    return {static_cast<Type>(reference_point.longitude()), _sinU1, _cosU1, _sinOmn, _cosOmn, _sinA0, _cos2a0,
+            _sin2q1, _cos2q1, _kA, _kBA, _kC};
+}
+
+//Прямая задача по заранее вычисленным слагаемым: точка на дальности range по геодезической линии
+template<c_point2d_geo PointGeo, std::floating_point Type,
+         c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>, c_ellipsoid Ellipsoid = pz90<Type>>
+constexpr PointGeo common_survey_comp(Type range, const direct_terms<Type> &terms){
+    constexpr auto _sqrtE2 = Ellipsoid::axis_ratio;
+    const auto [_lon1, _sinU1, _cosU1, _sinOmn, _cosOmn, _sinA0, _cos2a0, _sin2q1, _cos2q1, _kA, _kBA, _kC] = terms;
 
-    auto _q = range / (_kA * semiminor_axis<Type>);
+    auto _q = range / (_kA * Ellipsoid::semiminor_axis);
     const auto _qD = _q;
-    auto _cos2q1_q = algorithm::determine(_cos2q1, _sin2q1, ClassFunc::sin(_q), ClassFunc::cos(_q));
-    _q = _qD + _kBA * ClassFunc::sin(_q) * _cos2q1_q;
-    _cos2q1_q = algorithm::determine(_cos2q1, _sin2q1, ClassFunc::sin(_q), ClassFunc::cos(_q));
+    auto [_sinq, _cosq] = algorithm::sincos<ClassFunc>(_q);
+    auto _cos2q1_q = algorithm::determine(_cos2q1, _sin2q1, _sinq, _cosq);
+    _q = _qD + _kBA * _sinq * _cos2q1_q;
+    std::tie(_sinq, _cosq) = algorithm::sincos<ClassFunc>(_q);
+    _cos2q1_q = algorithm::determine(_cos2q1, _sin2q1, _sinq, _cosq);
     const auto _cos4q1_2q = 2 * _cos2q1_q * _cos2q1_q - 1;
-    _q = _qD + _kBA * ClassFunc::sin(_q) * _cos2q1_q + (_kC / _kA) * ClassFunc::sin(2 * _q) * _cos4q1_2q;
-    _cos2q1_q = algorithm::determine(_cos2q1, _sin2q1, ClassFunc::sin(_q), ClassFunc::cos(_q));
+    _q = _qD + _kBA * _sinq * _cos2q1_q + (_kC / _kA) * ClassFunc::sin(2 * _q) * _cos4q1_2q;
+    std::tie(_sinq, _cosq) = algorithm::sincos<ClassFunc>(_q);
+    _cos2q1_q = algorithm::determine(_cos2q1, _sin2q1, _sinq, _cosq);
 
-    const auto _cosQ = ClassFunc::cos(_q);
-    const auto _sinQ = ClassFunc::sin(_q) * _cosOmn;
+    const auto _cosQ = _cosq;
+    const auto _sinQ = _sinq * _cosOmn;
 
     const auto _cosU2 = algorithm::determine(_cosU1, _sinU1, _sinQ, _cosQ);
-    const auto _dY = ClassFunc::atan2(ClassFunc::sin(_q) * _sinOmn , _cosU2);
+    const auto _dY = ClassFunc::atan2(_sinq * _sinOmn , _cosU2);
     const auto _sinU2 = algorithm::determine(_sinU1, -_cosU1, _sinQ, _cosQ);
 
     const auto latitude = ClassFunc::atan(_sinU2 * ClassFunc::cos(_dY) / (_sqrtE2 * _cosU2));
-    auto longitude = reference_point.longitude() + _dY - ClassFunc::sin(_a0) * ((0.5 + _e2 / 8.0 - (_e2 / 16.0) * _cos2a0)
-                                                                                    * _e2 * _q + _e2 * _e2 * _cos2a0 / 16.0 * ClassFunc::sin(_q) * _cos2q1_q);
+    auto longitude = _lon1 + _dY - _sinA0 * ((Ellipsoid::longitude_c1 - Ellipsoid::longitude_c2 * _cos2a0) * _q
+                                             + Ellipsoid::longitude_c2 * _cos2a0 * _sinq * _cos2q1_q);
 
     if(longitude > algorithm::pi<decltype(longitude)>){
         while(longitude > algorithm::pi<decltype(longitude)>){
@@ -100,39 +129,74 @@ constexpr PointGeo common_survey_comp(Type range, TypeAngle omnibearing, const P
     return PointGeo(Angle(latitude), Angle(longitude));
 }
 
+template<std::floating_point Type, std::floating_point TypeAngle, c_point2d_geo PointGeo,
+         c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>, c_ellipsoid Ellipsoid = pz90<Type>>
+constexpr PointGeo common_survey_comp(Type range, TypeAngle omnibearing, const PointGeo &reference_point){
+    if(algorithm::compare(range, 0.) && (omnibearing == TypeAngle())){
+        return reference_point;
+    }
+    return common_survey_comp<PointGeo, Type, ClassFunc, Ellipsoid>(
+        range, prepare_direct<Type, TypeAngle, PointGeo, ClassFunc, Ellipsoid>(omnibearing, reference_point));
+}
+
+//Слагаемые обратной задачи, зависящие только от одной точки: приведённая широта и долгота
+template<std::floating_point Type>
+struct reduced_point{
+    Type latitude;
+    Type longitude;
+    Type sin_u;
+    Type cos_u;
+};
+
 template<c_point2d_geo PointGeo,
-         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>>
-constexpr auto geographic_inverse(const PointGeo &start, const PointGeo &stop)
-    -> std::tuple<typename PointGeo::type_coordinate, typename PointGeo::type_coordinate>{
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+constexpr auto reduce(const PointGeo &point) -> reduced_point<typename PointGeo::type_coordinate>{
     using TypeAngle = PointGeo::type_coordinate;
-    if(start == stop){
+    const auto [_sinU, _cosU] = reduced_latitude<ClassFunc, Ellipsoid>(point);
+    return {static_cast<TypeAngle>(point.latitude()), static_cast<TypeAngle>(point.longitude()), _sinU, _cosU};
+}
+
+//Пакетное построение точек с кэшем (например point_geo2d_prepared) для многократных запросов по одному набору
+template<c_point2d_geo Prepared, c_point2d_geo PointGeo>
+std::vector<Prepared> prepare(const std::vector<PointGeo> &points){
+    std::vector<Prepared> temp;
+    temp.reserve(points.size());
+    for(const auto &point : points){
+        temp.emplace_back(point);
+    }
+    return temp;
+}
+
+template<std::floating_point TypeAngle, c_function_angle<TypeAngle> ClassFunc = algorithm::function_angle<TypeAngle>,
+         c_ellipsoid Ellipsoid = pz90<TypeAngle>>
+constexpr std::tuple<TypeAngle, TypeAngle> geographic_inverse(const reduced_point<TypeAngle> &start,
+                                                              const reduced_point<TypeAngle> &stop){
+    if(algorithm::compare(start.latitude, stop.latitude) && algorithm::compare(start.longitude, stop.longitude)){
         return {};
     }
-    const auto _e2 = eccentricity2_1<TypeAngle>();
-    auto _sinLat = ClassFunc::sin(start.latitude());
-    auto _os = sqrt( 1.0 - _e2 * _sinLat * _sinLat );
-    const auto _sinU1 = _sinLat * sqrt( 1.0 - _e2 ) / _os;
-    const auto _cosU1 = ClassFunc::cos(start.latitude()) / _os;
-    _sinLat = ClassFunc::sin(stop.latitude());
-    _os = sqrt( 1.0 - _e2 * _sinLat * _sinLat );
-    const auto _sinU2 = _sinLat * sqrt( 1.0 - _e2 ) / _os;
-    const auto _cosU2 =  ClassFunc::cos(stop.latitude()) / _os;
-
-    const auto _dL = (stop.longitude() - start.longitude());
-
-    auto _p = _cosU2 * ClassFunc::sin( _dL );
-    auto _q = algorithm::determine(_cosU1, _sinU1, _cosU2 * ClassFunc::cos(_dL), _sinU2);
-    auto _n = algorithm::determine(_sinU1, -_cosU1, _cosU2 * ClassFunc::cos(_dL), _sinU2);
+    const auto _sinU1 = start.sin_u;
+    const auto _cosU1 = start.cos_u;
+    const auto _sinU2 = stop.sin_u;
+    const auto _cosU2 = stop.cos_u;
+
+    const auto _dL = (stop.longitude - start.longitude);
+
+    auto [_sinD, _cosD] = algorithm::sincos<ClassFunc>(static_cast<TypeAngle>(_dL));
+    auto _p = _cosU2 * _sinD;
+    auto _q = algorithm::determine(_cosU1, _sinU1, _cosU2 * _cosD, _sinU2);
+    auto _n = algorithm::determine(_sinU1, -_cosU1, _cosU2 * _cosD, _sinU2);
     auto _omnibearing = ClassFunc::atan2( _p , _q );
-    auto _g = acos( _n );
+    auto _g = ClassFunc::acos( _n );
     const auto _sinA0 = _cosU1 * ClassFunc::sin(_omnibearing);
     auto _a0 = ClassFunc::cos(ClassFunc::asin(_sinA0));
     _a0 *= _a0;
-    const auto _dY = _dL + _sinA0 * ( 0.5 + _e2 / 8.0 - ( _e2 / 16.0 ) * _a0 ) * _e2 * _g;
+    const auto _dY = _dL + _sinA0 * ( Ellipsoid::longitude_c1 - Ellipsoid::longitude_c2 * _a0 ) * _g;
 
-    _p = _cosU2 * ClassFunc::sin(_dY);
-    _q = algorithm::determine(_cosU1, _sinU1, _cosU2 * ClassFunc::cos(_dY), _sinU2);
-    _n = algorithm::determine(_sinU1, -_cosU1, _cosU2 * ClassFunc::cos(_dY), _sinU2);
+    std::tie(_sinD, _cosD) = algorithm::sincos<ClassFunc>(static_cast<TypeAngle>(_dY));
+    _p = _cosU2 * _sinD;
+    _q = algorithm::determine(_cosU1, _sinU1, _cosU2 * _cosD, _sinU2);
+    _n = algorithm::determine(_sinU1, -_cosU1, _cosU2 * _cosD, _sinU2);
     _omnibearing = ClassFunc::atan2(_p , _q);
     _g = ClassFunc::acos(_n);
     _a0 = ClassFunc::cos(ClassFunc::asin(ClassFunc::sin(_omnibearing) * _cosU1));
@@ -141,19 +205,505 @@ constexpr auto geographic_inverse(const PointGeo &start, const PointGeo &stop)
         _omnibearing += 2 * algorithm::pi<decltype(_omnibearing)>;
     }
     const auto _g1 = ClassFunc::atan2(_sinU1 , (_cosU1 * ClassFunc::cos(_omnibearing)));
-    const auto _e2h = eccentricity2_2<TypeAngle>();
-    const auto _k2 = _e2h * _a0;
+    const auto _k2 = Ellipsoid::eccentricity2_2 * _a0;
     const auto _k2_2 = _k2 * _k2;
 
-    const auto _range = ( 1.0 + _k2 / 4.0 - 3.0 * _k2_2 / 64.0 ) * semiminor_axis<TypeAngle> * _g -
-                  ( _k2 / 4.0 - _k2_2 / 16.0 ) * semiminor_axis<TypeAngle>
-                      * ClassFunc::sin(_g) * cos( 2 * _g1 + _g ) -
-                  ( _k2_2 / 128.0 ) * semiminor_axis<TypeAngle>
-                      * ClassFunc::sin(2 * _g) * cos( 4 * _g1 + 2 * _g );
+    const auto _range = ( 1.0 + _k2 / 4.0 - 3.0 * _k2_2 / 64.0 ) * Ellipsoid::semiminor_axis * _g -
+                  ( _k2 / 4.0 - _k2_2 / 16.0 ) * Ellipsoid::semiminor_axis
+                      * ClassFunc::sin(_g) * ClassFunc::cos( 2 * _g1 + _g ) -
+                  ( _k2_2 / 128.0 ) * Ellipsoid::semiminor_axis
+                      * ClassFunc::sin(2 * _g) * ClassFunc::cos( 4 * _g1 + 2 * _g );
 
     return {_range, _omnibearing};
 }
 
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+constexpr auto geographic_inverse(const PointGeo &start, const PointGeo &stop)
+    -> std::tuple<typename PointGeo::type_coordinate, typename PointGeo::type_coordinate>{
+    using TypeAngle = PointGeo::type_coordinate;
+    if(start == stop){
+        return {};
+    }
+    return geographic_inverse<TypeAngle, ClassFunc, Ellipsoid>(reduce<PointGeo, ClassFunc, Ellipsoid>(start),
+                                                               reduce<PointGeo, ClassFunc, Ellipsoid>(stop));
+}
+
+//Дальность и азимут на сфере среднего радиуса (гаверсинус). Тот же интерфейс, что у geographic_inverse;
+//от эллипсоидального решения дальность отличается не больше чем на spherical_error от дальности
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+constexpr auto spherical_inverse(const PointGeo &start, const PointGeo &stop)
+    -> std::tuple<typename PointGeo::type_coordinate, typename PointGeo::type_coordinate>{
+    using Type = PointGeo::type_coordinate;
+    const auto [sin_lat1, cos_lat1] = latitude_sincos<ClassFunc>(start);
+    const auto [sin_lat2, cos_lat2] = latitude_sincos<ClassFunc>(stop);
+    const auto [sin_dl, cos_dl] = algorithm::sincos<ClassFunc>(static_cast<Type>(stop.longitude() - start.longitude()));
+    const auto sin_half_lat = ClassFunc::sin(static_cast<Type>(stop.latitude() - start.latitude()) / 2);
+    const auto sin_half_lon = ClassFunc::sin(static_cast<Type>(stop.longitude() - start.longitude()) / 2);
+    const auto h = sin_half_lat * sin_half_lat + cos_lat1 * cos_lat2 * sin_half_lon * sin_half_lon;
+    const auto range = 2 * Ellipsoid::mean_radius * ClassFunc::atan2(std::sqrt(h), std::sqrt(std::max(Type(1) - h, Type())));
+    auto omnibearing = ClassFunc::atan2(sin_dl * cos_lat2, cos_lat1 * sin_lat2 - sin_lat1 * cos_lat2 * cos_dl);
+    if(omnibearing < 0){
+        omnibearing += 2 * algorithm::pi<Type>;
+    }
+    return {range, omnibearing};
+}
+
+//Наибольшее относительное расхождение дальности spherical_inverse и geographic_inverse (измерено 0.0057)
+template<std::floating_point Type>
+inline constexpr Type spherical_error = 0.006;
+
+//Единичный вектор нормали сферы в точке (для пакетной обработки через скалярное произведение)
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>>
+constexpr auto unit_vector(const PointGeo &point) -> std::array<typename PointGeo::type_coordinate, 3>{
+    using Type = PointGeo::type_coordinate;
+    const auto [sin_lat, cos_lat] = latitude_sincos<ClassFunc>(point);
+    const auto [sin_lon, cos_lon] = algorithm::sincos<ClassFunc>(static_cast<Type>(point.longitude()));
+    return {cos_lat * cos_lon, cos_lat * sin_lon, sin_lat};
+}
+
+//Дальность между точками, заданными единичными векторами
+template<std::floating_point Type, c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>,
+         c_ellipsoid Ellipsoid = pz90<Type>>
+constexpr Type spherical_range(const std::array<Type, 3> &vector1, const std::array<Type, 3> &vector2){
+    const auto cx = vector1[1] * vector2[2] - vector1[2] * vector2[1];
+    const auto cy = vector1[2] * vector2[0] - vector1[0] * vector2[2];
+    const auto cz = vector1[0] * vector2[1] - vector1[1] * vector2[0];
+    const auto dot = vector1[0] * vector2[0] + vector1[1] * vector2[1] + vector1[2] * vector2[2];
+    return Ellipsoid::mean_radius * ClassFunc::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot);
+}
+
+//Проверка "ближе threshold": сферическая дальность уточняется решением на эллипсоиде,
+//только если она попала в полосу band вокруг порога
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+constexpr bool within(const PointGeo &start, const PointGeo &stop, typename PointGeo::type_coordinate threshold,
+                      typename PointGeo::type_coordinate band){
+    const auto range = std::get<0>(spherical_inverse<PointGeo, ClassFunc, Ellipsoid>(start, stop));
+    if(std::abs(range - threshold) > band){
+        return range < threshold;
+    }
+    return std::get<0>(geographic_inverse<PointGeo, ClassFunc, Ellipsoid>(start, stop)) < threshold;
+}
+
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+constexpr bool within(const PointGeo &start, const PointGeo &stop, typename PointGeo::type_coordinate threshold){
+    using Type = PointGeo::type_coordinate;
+    return within<PointGeo, ClassFunc, Ellipsoid>(start, stop, threshold, threshold * spherical_error<Type>);
+}
+
+//Все пары точек ближе threshold. Отбор идёт по скалярному произведению единичных векторов
+//(cos угла против cos порога), решение на эллипсоиде считается только для пар в полосе band вокруг порога
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+std::vector<std::pair<size_t, size_t>> proximity(const std::vector<PointGeo> &points, typename PointGeo::type_coordinate threshold,
+                                                 typename PointGeo::type_coordinate band){
+    using Type = PointGeo::type_coordinate;
+    std::vector<std::array<Type, 3>> vectors;
+    vectors.reserve(points.size());
+    for(const auto &point : points){
+        vectors.push_back(unit_vector<PointGeo, ClassFunc>(point));
+    }
+    constexpr auto radius = Ellipsoid::mean_radius;
+    const auto cos_inner = ClassFunc::cos(std::clamp((threshold - band) / radius, Type(), algorithm::pi<Type>));
+    const auto cos_outer = ClassFunc::cos(std::clamp((threshold + band) / radius, Type(), algorithm::pi<Type>));
+    const auto cos_threshold = ClassFunc::cos(std::clamp(threshold / radius, Type(), algorithm::pi<Type>));
+    const auto refine = band > 0;
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for(size_t i = 0; i < vectors.size(); ++i){
+        const auto &vector1 = vectors[i];
+        for(size_t j = i + 1; j < vectors.size(); ++j){
+            const auto &vector2 = vectors[j];
+            const auto dot = vector1[0] * vector2[0] + vector1[1] * vector2[1] + vector1[2] * vector2[2];
+            if(refine && (dot <= cos_inner) && (dot >= cos_outer)){
+                if(std::get<0>(geographic_inverse<PointGeo, ClassFunc, Ellipsoid>(points[i], points[j])) < threshold){
+                    pairs.emplace_back(i, j);
+                }
+            }
+            else if(dot > cos_threshold){
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+std::vector<std::pair<size_t, size_t>> proximity(const std::vector<PointGeo> &points, typename PointGeo::type_coordinate threshold){
+    using Type = PointGeo::type_coordinate;
+    return proximity<PointGeo, ClassFunc, Ellipsoid>(points, threshold, threshold * spherical_error<Type>);
+}
+
+//Число отрезков, на которое надо разбить дугу длиной length и радиусом кривизны radius,
+//чтобы хорды отстояли от неё не дальше tolerance
+template<std::floating_point Type>
+constexpr size_t chord_count(Type length, Type radius, Type tolerance){
+    if(!(tolerance > 0) || !(length > 0) || !(radius > 0)){
+        return 1;
+    }
+    const auto step = (tolerance < radius) ? 2 * radius * std::acos(1 - tolerance / radius) : algorithm::pi<Type> * radius;
+    return std::max<size_t>(static_cast<size_t>(std::ceil(length / step)), 1);
+}
+
+//Равноотстоящие точки геодезической линии от начала до конца отрезка, заполняет весь points.
+//Обратная задача решается один раз, слагаемые прямой задачи общие для всех точек
+template<c_line_section LineGeo,
+         c_function_angle<typename LineGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename LineGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename LineGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename LineGeo::type_point>
+constexpr void densify(const LineGeo &line, std::span<typename LineGeo::type_point> points){
+    using PointGeo = LineGeo::type_point;
+    using Type = PointGeo::type_coordinate;
+    if(points.empty()){
+        return;
+    }
+    points.front() = line.start();
+    if(points.size() == 1){
+        return;
+    }
+    const auto [range, omnibearing] = geographic_inverse<PointGeo, ClassFunc, Ellipsoid>(line.start(), line.stop());
+    const auto terms = prepare_direct<Type, Type, PointGeo, ClassFunc, Ellipsoid>(omnibearing, line.start());
+    const auto step = range / (points.size() - 1);
+    for(size_t i = 1; i + 1 < points.size(); ++i){
+        points[i] = common_survey_comp<PointGeo, Type, ClassFunc, Ellipsoid>(i * step, terms);
+    }
+    points.back() = line.stop();
+}
+
+//count_point + 1 равноотстоящих точек геодезической линии
+template<c_line_section LineGeo,
+         c_function_angle<typename LineGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename LineGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename LineGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename LineGeo::type_point>
+std::vector<typename LineGeo::type_point> densify(const LineGeo &line, size_t count_point){
+    std::vector<typename LineGeo::type_point> points(std::max<size_t>(count_point, 1) + 1, line.start());
+    densify<LineGeo, ClassFunc, Ellipsoid>(line, std::span(points));
+    return points;
+}
+
+//Число отрезков для densify, при котором хорды отстоят от геодезической линии не дальше tolerance
+template<c_line_section LineGeo,
+         c_function_angle<typename LineGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename LineGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename LineGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename LineGeo::type_point>
+constexpr size_t densify_count(const LineGeo &line, typename LineGeo::type_point::type_coordinate tolerance){
+    using PointGeo = LineGeo::type_point;
+    const auto range = std::get<0>(geographic_inverse<PointGeo, ClassFunc, Ellipsoid>(line.start(), line.stop()));
+    return chord_count(range, Ellipsoid::mean_radius, tolerance);
+}
+
+template<c_line_section LineGeo,
+         c_function_angle<typename LineGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename LineGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename LineGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename LineGeo::type_point>
+std::vector<typename LineGeo::type_point> densify_tolerance(const LineGeo &line, typename LineGeo::type_point::type_coordinate tolerance){
+    return densify<LineGeo, ClassFunc, Ellipsoid>(line, densify_count<LineGeo, ClassFunc, Ellipsoid>(line, tolerance));
+}
+
+//Равноотстоящие по азимуту точки дуги в заданном направлении обхода, заполняет весь points
+template<c_arc ArcGeo,
+         c_function_angle<typename ArcGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename ArcGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename ArcGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename ArcGeo::type_point>
+constexpr void densify(const ArcGeo &arc, std::span<typename ArcGeo::type_point> points,
+                       algorithm::direct direct = algorithm::direct::RIGHT){
+    using PointGeo = ArcGeo::type_point;
+    using Type = PointGeo::type_coordinate;
+    const auto start = (direct == algorithm::direct::RIGHT) ? arc.start() : arc.stop();
+    auto stop = (direct == algorithm::direct::RIGHT) ? arc.stop() : arc.start();
+    if(start > stop){
+        stop += algorithm::pi_in_2<Type>;
+    }
+    const auto da = (points.size() > 1) ? (stop - start) / (points.size() - 1) : Type();
+    const auto center = arc.center();
+    for(size_t i = 0; i < points.size(); ++i){
+        const auto terms = prepare_direct<Type, Type, PointGeo, ClassFunc, Ellipsoid>(start + i * da, center);
+        points[i] = common_survey_comp<PointGeo, Type, ClassFunc, Ellipsoid>(static_cast<Type>(arc.radius()), terms);
+    }
+}
+
+template<c_arc ArcGeo,
+         c_function_angle<typename ArcGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename ArcGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename ArcGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename ArcGeo::type_point>
+std::vector<typename ArcGeo::type_point> densify(const ArcGeo &arc, size_t count_point, algorithm::direct direct = algorithm::direct::RIGHT){
+    std::vector<typename ArcGeo::type_point> points(std::max<size_t>(count_point, 1) + 1, arc.center());
+    densify<ArcGeo, ClassFunc, Ellipsoid>(arc, std::span(points), direct);
+    return points;
+}
+
+template<c_arc ArcGeo>
+    requires c_point2d_geo<typename ArcGeo::type_point>
+constexpr size_t densify_count(const ArcGeo &arc, typename ArcGeo::type_point::type_coordinate tolerance,
+                               algorithm::direct direct = algorithm::direct::RIGHT){
+    using Type = ArcGeo::type_point::type_coordinate;
+    auto sweep = (direct == algorithm::direct::RIGHT) ? arc.stop() - arc.start() : arc.start() - arc.stop();
+    if(sweep < 0){
+        sweep += algorithm::pi_in_2<Type>;
+    }
+    return chord_count(sweep * arc.radius(), static_cast<Type>(arc.radius()), tolerance);
+}
+
+template<c_arc ArcGeo,
+         c_function_angle<typename ArcGeo::type_point::type_coordinate> ClassFunc = algorithm::function_angle<typename ArcGeo::type_point::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename ArcGeo::type_point::type_coordinate>>
+    requires c_point2d_geo<typename ArcGeo::type_point>
+std::vector<typename ArcGeo::type_point> densify_tolerance(const ArcGeo &arc, typename ArcGeo::type_point::type_coordinate tolerance,
+                                                           algorithm::direct direct = algorithm::direct::RIGHT){
+    return densify<ArcGeo, ClassFunc, Ellipsoid>(arc, densify_count(arc, tolerance, direct), direct);
+}
+
+namespace {
+
+//Обходит плитки tile x tile матрицы rows x columns в threads потоках. Для симметричной матрицы
+//обходятся только плитки на диагонали и выше неё
+template<typename Func>
+void for_each_tile(size_t rows, size_t columns, size_t tile, size_t threads, bool symmetric, Func &&func){
+    tile = std::max<size_t>(tile, 1);
+    std::vector<std::pair<size_t, size_t>> tiles;
+    for(size_t row = 0; row < rows; row += tile){
+        for(size_t column = symmetric ? row : 0; column < columns; column += tile){
+            tiles.emplace_back(row, column);
+        }
+    }
+    threads = std::clamp<size_t>(threads, 1, std::max<size_t>(tiles.size(), 1));
+    std::atomic<size_t> next{};
+    auto work = [&](){
+        for(auto i = next++; i < tiles.size(); i = next++){
+            const auto [row, column] = tiles[i];
+            func(row, std::min(row + tile, rows), column, std::min(column + tile, columns));
+        }
+    };
+    if(threads == 1){
+        work();
+        return;
+    }
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(threads);
+    for(size_t i = 0; i < threads; ++i){
+        tasks.push_back(std::async(std::launch::async, work));
+    }
+    for(auto &task : tasks){
+        task.get();
+    }
+}
+
+template<typename Matrix>
+concept c_strided_matrix = requires(Matrix matrix){
+    matrix.data(); matrix.rows(); matrix.columns(); matrix.stride();
+};
+
+}
+
+//Матрица дальностей между точками rows и columns: элемент (i, j) пишется в buffer[i * stride + j].
+//Слагаемые каждой точки (приведённая широта) считаются один раз, расчёт идёт плитками tile x tile в threads потоках
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+void distance_matrix(const std::vector<PointGeo> &rows, const std::vector<PointGeo> &columns,
+                     std::span<typename PointGeo::type_coordinate> buffer, size_t stride, size_t threads = 1, size_t tile = 64){
+    using Type = PointGeo::type_coordinate;
+    if((stride < columns.size()) || (!rows.empty() && (buffer.size() < (rows.size() - 1) * stride + columns.size()))){
+        throw std::logic_error("distance_matrix: buffer is too small");
+    }
+    std::vector<reduced_point<Type>> reduced_rows;
+    reduced_rows.reserve(rows.size());
+    for(const auto &point : rows){
+        reduced_rows.push_back(reduce<PointGeo, ClassFunc, Ellipsoid>(point));
+    }
+    std::vector<reduced_point<Type>> reduced_columns;
+    reduced_columns.reserve(columns.size());
+    for(const auto &point : columns){
+        reduced_columns.push_back(reduce<PointGeo, ClassFunc, Ellipsoid>(point));
+    }
+    for_each_tile(rows.size(), columns.size(), tile, threads, false,
+                  [&reduced_rows, &reduced_columns, buffer, stride](size_t row_begin, size_t row_end, size_t column_begin, size_t column_end){
+        for(auto i = row_begin; i < row_end; ++i){
+            for(auto j = column_begin; j < column_end; ++j){
+                buffer[i * stride + j] = std::get<0>(geographic_inverse<Type, ClassFunc, Ellipsoid>(reduced_rows[i], reduced_columns[j]));
+            }
+        }
+    });
+}
+
+//Симметричная матрица дальностей между точками points: считается только половина над диагональю,
+//вторая половина заполняется отражением
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+void distance_matrix(const std::vector<PointGeo> &points, std::span<typename PointGeo::type_coordinate> buffer, size_t stride,
+                     size_t threads = 1, size_t tile = 64){
+    using Type = PointGeo::type_coordinate;
+    if((stride < points.size()) || (!points.empty() && (buffer.size() < (points.size() - 1) * stride + points.size()))){
+        throw std::logic_error("distance_matrix: buffer is too small");
+    }
+    std::vector<reduced_point<Type>> reduced;
+    reduced.reserve(points.size());
+    for(const auto &point : points){
+        reduced.push_back(reduce<PointGeo, ClassFunc, Ellipsoid>(point));
+    }
+    for_each_tile(points.size(), points.size(), tile, threads, true,
+                  [&reduced, buffer, stride](size_t row_begin, size_t row_end, size_t column_begin, size_t column_end){
+        for(auto i = row_begin; i < row_end; ++i){
+            if(column_begin == row_begin){
+                buffer[i * stride + i] = Type();
+            }
+            for(auto j = std::max(column_begin, i + 1); j < column_end; ++j){
+                const auto range = std::get<0>(geographic_inverse<Type, ClassFunc, Ellipsoid>(reduced[i], reduced[j]));
+                buffer[i * stride + j] = range;
+                buffer[j * stride + i] = range;
+            }
+        }
+    });
+}
+
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>, c_strided_matrix Matrix>
+void distance_matrix(const std::vector<PointGeo> &rows, const std::vector<PointGeo> &columns, Matrix &matrix, size_t threads = 1){
+    if((matrix.rows() != rows.size()) || (matrix.columns() != columns.size())){
+        throw std::logic_error("distance_matrix: matrix size mismatch");
+    }
+    distance_matrix<PointGeo, ClassFunc, Ellipsoid>(rows, columns, std::span(matrix.data(), matrix.rows() * matrix.stride()),
+                                                    matrix.stride(), threads);
+}
+
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>, c_strided_matrix Matrix>
+void distance_matrix(const std::vector<PointGeo> &points, Matrix &matrix, size_t threads = 1){
+    if((matrix.rows() != points.size()) || (matrix.columns() != points.size())){
+        throw std::logic_error("distance_matrix: matrix size mismatch");
+    }
+    distance_matrix<PointGeo, ClassFunc, Ellipsoid>(points, std::span(matrix.data(), matrix.rows() * matrix.stride()),
+                                                    matrix.stride(), threads);
+}
+
+//Способ перевода между географическими и прямоугольными координатами
+enum class frame{
+    GEODESIC,      //!Прямая и обратная геодезические задачи на эллипсоиде
+    LOCAL_TANGENT, //!Местная касательная плоскость (ECEF -> ENU)
+};
+
+//Геоцентрические координаты (ECEF) точки с высотой altitude над эллипсоидом
+template<std::floating_point Type, c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>,
+         c_ellipsoid Ellipsoid = pz90<Type>>
+constexpr std::array<Type, 3> ecef(Type latitude, Type longitude, Type altitude = Type()){
+    constexpr auto e2 = Ellipsoid::eccentricity2;
+    const auto [sin_lat, cos_lat] = algorithm::sincos<ClassFunc>(latitude);
+    const auto [sin_lon, cos_lon] = algorithm::sincos<ClassFunc>(longitude);
+    const auto n = Ellipsoid::semimajor_axis / std::sqrt(1 - e2 * sin_lat * sin_lat);
+    return {(n + altitude) * cos_lat * cos_lon,
+            (n + altitude) * cos_lat * sin_lon,
+            (n * (1 - e2) + altitude) * sin_lat};
+}
+
+//Широта, долгота и высота по геоцентрическим координатам (метод Боуринга, две итерации)
+template<std::floating_point Type, c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>,
+         c_ellipsoid Ellipsoid = pz90<Type>>
+constexpr std::array<Type, 3> geodetic(const std::array<Type, 3> &point){
+    constexpr auto a = Ellipsoid::semimajor_axis;
+    constexpr auto b = Ellipsoid::semiminor_axis;
+    constexpr auto e2 = Ellipsoid::eccentricity2;
+    constexpr auto ep2 = Ellipsoid::eccentricity2_2;
+    const auto [x, y, z] = point;
+    const auto p = std::sqrt(x * x + y * y);
+    auto latitude = ClassFunc::atan2(z * a, p * b);
+    for(int i = 0; i < 2; ++i){
+        const auto [sin_u, cos_u] = algorithm::sincos<ClassFunc>(ClassFunc::atan2(b * ClassFunc::sin(latitude), a * ClassFunc::cos(latitude)));
+        latitude = ClassFunc::atan2(z + ep2 * b * sin_u * sin_u * sin_u, p - e2 * a * cos_u * cos_u * cos_u);
+    }
+    const auto [sin_lat, cos_lat] = algorithm::sincos<ClassFunc>(latitude);
+    const auto n = a / std::sqrt(1 - e2 * sin_lat * sin_lat);
+    const auto altitude = (std::abs(cos_lat) > std::abs(sin_lat)) ? p / cos_lat - n : z / sin_lat - n * (1 - e2);
+    return {latitude, ClassFunc::atan2(y, x), altitude};
+}
+
+//Местная касательная плоскость в опорной точке: ось x на восток, ось y на север, h вверх.
+//Геоцентрические координаты опорной точки и матрица поворота ECEF -> ENU считаются один раз в конструкторе.
+//Плоские координаты 2D точек лежат в касательной плоскости (высота отбрасывается), поэтому относительно
+//геодезических задач расхождение растёт как d^3/R^2: до 1 см на 10 км, около 4 м на 100 км
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+class local_frame{
+public:
+    using Type = PointGeo::type_coordinate;
+
+    explicit constexpr local_frame(const PointGeo &reference_point, Type altitude = Type())
+        : reference_(reference_point),
+        origin_(geo_algo::ecef<Type, ClassFunc, Ellipsoid>(static_cast<Type>(reference_point.latitude()), static_cast<Type>(reference_point.longitude()), altitude)){
+        const auto [sin_lat, cos_lat] = algorithm::sincos<ClassFunc>(static_cast<Type>(reference_point.latitude()));
+        const auto [sin_lon, cos_lon] = algorithm::sincos<ClassFunc>(static_cast<Type>(reference_point.longitude()));
+        rotation_ = {-sin_lon,           cos_lon,           Type(),
+                     -sin_lat * cos_lon, -sin_lat * sin_lon, cos_lat,
+                     cos_lat * cos_lon,  cos_lat * sin_lon,  sin_lat};
+    }
+
+    constexpr const PointGeo &reference() const{
+        return reference_;
+    }
+
+    //Геоцентрические координаты -> (восток, север, вверх)
+    constexpr std::array<Type, 3> enu(const std::array<Type, 3> &point) const{
+        const auto dx = point[0] - origin_[0];
+        const auto dy = point[1] - origin_[1];
+        const auto dz = point[2] - origin_[2];
+        return {rotation_[0] * dx + rotation_[1] * dy + rotation_[2] * dz,
+                rotation_[3] * dx + rotation_[4] * dy + rotation_[5] * dz,
+                rotation_[6] * dx + rotation_[7] * dy + rotation_[8] * dz};
+    }
+
+    //(восток, север, вверх) -> геоцентрические координаты
+    constexpr std::array<Type, 3> ecef(const std::array<Type, 3> &point) const{
+        const auto [e, n, u] = point;
+        return {origin_[0] + rotation_[0] * e + rotation_[3] * n + rotation_[6] * u,
+                origin_[1] + rotation_[1] * e + rotation_[4] * n + rotation_[7] * u,
+                origin_[2] + rotation_[2] * e + rotation_[5] * n + rotation_[8] * u};
+    }
+
+    template<c_point2d_decard Point>
+    constexpr Point to_local(const PointGeo &point) const{
+        const auto [e, n, u] = enu(geo_algo::ecef<Type, ClassFunc, Ellipsoid>(static_cast<Type>(point.latitude()),
+                                                                   static_cast<Type>(point.longitude())));
+        return Point(e, n);
+    }
+
+    //Точка эллипсоида, проекция которой вдоль вертикали опорной точки совпадает с point
+    template<c_point2d_decard Point>
+    constexpr PointGeo to_geo(const Point &point) const{
+        constexpr auto a2 = Ellipsoid::semimajor_axis * Ellipsoid::semimajor_axis;
+        constexpr auto b2 = Ellipsoid::semiminor_axis * Ellipsoid::semiminor_axis;
+        const auto [x, y, z] = ecef({static_cast<Type>(point.x()), static_cast<Type>(point.y()), Type()});
+        const auto [ux, uy, uz] = std::array{rotation_[6], rotation_[7], rotation_[8]};
+        //Пересечение прямой (x, y, z) + u * (ux, uy, uz) с эллипсоидом, берётся ближний к плоскости корень
+        const auto qa = (ux * ux + uy * uy) / a2 + uz * uz / b2;
+        const auto qb = (x * ux + y * uy) / a2 + z * uz / b2;
+        const auto qc = (x * x + y * y) / a2 + z * z / b2 - 1;
+        const auto discriminant = std::max(qb * qb - qa * qc, Type());
+        const auto u = -qc / (qb + std::sqrt(discriminant));
+        const auto [latitude, longitude, altitude] = geodetic<Type, ClassFunc, Ellipsoid>({x + u * ux, y + u * uy, z + u * uz});
+        using Angle = PointGeo::type_coordinate;
+        return PointGeo(Angle(latitude), Angle(longitude));
+    }
+
+private:
+    PointGeo reference_;
+    std::array<Type, 3> origin_;
+    std::array<Type, 9> rotation_{};
+};
+
 template<c_point2d_geo PointGeo, c_point2d_decard Point>
 constexpr PointGeo convert(const Point &point, const PointGeo &reference_poin){
     return common_survey_comp(point_algo::distance(Point(), point), point_algo::angle(Point(), point), reference_poin);
@@ -165,6 +715,32 @@ constexpr Point convert(const PointGeo &point, const PointGeo &reference_poin){
     return point_algo::new_point(Point(), std::get<1>(temp), std::get<0>(temp));
 }
 
+template<c_point2d_geo PointGeo, c_point2d_decard Point>
+constexpr PointGeo convert(const Point &point, const PointGeo &reference_poin, frame mode){
+    if(mode == frame::LOCAL_TANGENT){
+        return local_frame<PointGeo>(reference_poin).to_geo(point);
+    }
+    return convert<PointGeo>(point, reference_poin);
+}
+
+template<c_point2d_decard Point, c_point2d_geo PointGeo>
+constexpr Point convert(const PointGeo &point, const PointGeo &reference_poin, frame mode){
+    if(mode == frame::LOCAL_TANGENT){
+        return local_frame<PointGeo>(reference_poin).template to_local<Point>(point);
+    }
+    return convert<Point>(point, reference_poin);
+}
+
+template<c_point2d PointOut, c_point2d PointIn, c_point2d_geo PointGeo, typename ClassFunc, typename Ellipsoid>
+constexpr PointOut convert(const PointIn &point, const local_frame<PointGeo, ClassFunc, Ellipsoid> &local){
+    if constexpr(c_point2d_geo<PointOut>){
+        return local.to_geo(point);
+    }
+    else{
+        return local.template to_local<PointOut>(point);
+    }
+}
+
 template<c_point2d_polar Polar, c_point2d_geo PointGeo>
 constexpr PointGeo convert(const Polar &point, const PointGeo &reference_poin){
     return common_survey_comp(point.psi(), point.fi(), reference_poin);
@@ -215,6 +791,16 @@ constexpr std::vector<PointOut> convert(const std::vector<PointIn> &points, cons
     return temp;
 }
 
+template<c_point2d PointOut, c_point2d PointIn, c_point2d_geo PointGeo, typename ClassFunc, typename Ellipsoid>
+constexpr std::vector<PointOut> convert(const std::vector<PointIn> &points, const local_frame<PointGeo, ClassFunc, Ellipsoid> &local){
+    std::vector<PointOut> temp;
+    temp.reserve(points.size());
+    std::transform(std::begin(points), std::end(points), std::back_inserter(temp),[&local](const auto &item){
+        return convert<PointOut>(item, local);
+    });
+    return temp;
+}
+
 template<c_line_section LineOut, c_line_section LineIn, c_point2d_geo PointGeo>
 constexpr std::vector<LineOut> convert(const std::vector<LineIn> &points, const PointGeo &reference_poin){
     std::vector<LineOut> temp;
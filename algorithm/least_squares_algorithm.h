@@ -0,0 +1,269 @@
+#ifndef LEAST_SQUARES_ALGORITHM_H
+#define LEAST_SQUARES_ALGORITHM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "../structs/matrix.h"
+#include "../structs/vector.h"
+
+namespace agl::matrix_algo{
+
+namespace {
+
+//Порог вырожденности треугольной матрицы по её диагонали
+template<std::floating_point Type, size_t N>
+constexpr Type singular_threshold(const std::array<Type, N * N> &r){
+    Type max_diagonal{};
+    for(size_t i = 0; i < N; ++i){
+        max_diagonal = std::max(max_diagonal, std::abs(r[i * N + i]));
+    }
+    return max_diagonal * N * std::numeric_limits<Type>::epsilon();
+}
+
+}
+
+//Метод наименьших квадратов через нормальные уравнения A^T A x = A^T b.
+//Наблюдение добавляется за O(N^2) накоплением A^T A и A^T b, решение - разложение Холецкого за O(N^3).
+//Быстрее QR, но число обусловленности возводится в квадрат: для плохо обусловленных задач следует брать least_squares_qr
+template<std::floating_point Type, size_t N>
+class least_squares_normal{
+public:
+    using type = Type;
+    static constexpr size_t unknowns = N;
+
+    //Наблюдение row * x = value с весом weight
+    constexpr void add(const std::array<Type, N> &row, Type value, Type weight = 1){
+        for(size_t i = 0; i < N; ++i){
+            const auto wi = weight * row[i];
+            for(size_t j = i; j < N; ++j){
+                ata_[i * N + j] += wi * row[j];
+            }
+            atb_[i] += wi * value;
+        }
+        btb_ += weight * value * value;
+        ++count_;
+    }
+    constexpr void add(const vector<Type, N> &row, Type value, Type weight = 1){
+        std::array<Type, N> temp;
+        std::ranges::copy(row, temp.begin());
+        add(temp, value, weight);
+    }
+
+    //Забывание: вес накопленных наблюдений умножается на lambda (0 < lambda <= 1)
+    constexpr void forget(Type lambda){
+        for(auto &value : ata_){
+            value *= lambda;
+        }
+        for(auto &value : atb_){
+            value *= lambda;
+        }
+        btb_ *= lambda;
+    }
+
+    constexpr void clear(){
+        *this = least_squares_normal();
+    }
+    constexpr size_t size() const{
+        return count_;
+    }
+
+    //Решение. Пустое значение - система вырождена (наблюдений мало или они линейно зависимы)
+    constexpr std::optional<vector<Type, N>> solve() const{
+        //Холецкий: A^T A = L L^T, L хранится в нижнем треугольнике по строкам
+        std::array<Type, N * N> l{};
+        for(size_t j = 0; j < N; ++j){
+            auto diagonal = ata_[j * N + j];
+            for(size_t k = 0; k < j; ++k){
+                diagonal -= l[j * N + k] * l[j * N + k];
+            }
+            if(diagonal <= ata_[j * N + j] * N * std::numeric_limits<Type>::epsilon()){
+                return std::nullopt;
+            }
+            l[j * N + j] = std::sqrt(diagonal);
+            for(size_t i = j + 1; i < N; ++i){
+                auto value = ata_[j * N + i];
+                for(size_t k = 0; k < j; ++k){
+                    value -= l[i * N + k] * l[j * N + k];
+                }
+                l[i * N + j] = value / l[j * N + j];
+            }
+        }
+        std::array<Type, N> y;
+        for(size_t i = 0; i < N; ++i){
+            auto value = atb_[i];
+            for(size_t k = 0; k < i; ++k){
+                value -= l[i * N + k] * y[k];
+            }
+            y[i] = value / l[i * N + i];
+        }
+        vector<Type, N> temp(uninitialized);
+        auto x = temp.begin();
+        for(size_t i = N; i-- > 0;){
+            auto value = y[i];
+            for(size_t k = i + 1; k < N; ++k){
+                value -= l[k * N + i] * x[k];
+            }
+            x[i] = value / l[i * N + i];
+        }
+        return temp;
+    }
+
+    //Взвешенная сумма квадратов невязок решения x
+    constexpr Type residual(const vector<Type, N> &x) const{
+        auto temp = btb_;
+        for(size_t i = 0; i < N; ++i){
+            temp -= 2 * x.get(i) * atb_[i];
+            temp += x.get(i) * x.get(i) * ata_[i * N + i];
+            for(size_t j = i + 1; j < N; ++j){
+                temp += 2 * x.get(i) * x.get(j) * ata_[i * N + j];
+            }
+        }
+        return std::max(temp, Type{});
+    }
+
+private:
+    std::array<Type, N * N> ata_{};   //!Верхний треугольник A^T A
+    std::array<Type, N> atb_{};
+    Type btb_{};
+    size_t count_{};
+};
+
+//Метод наименьших квадратов через QR-разложение вращениями Гивенса.
+//Хранится только треугольная R и Q^T b: наблюдение добавляется за O(N^2), решение - обратная подстановка за O(N^2),
+//поэтому оценка уточняется после каждого наблюдения без повторного решения всей задачи
+template<std::floating_point Type, size_t N>
+class least_squares_qr{
+public:
+    using type = Type;
+    static constexpr size_t unknowns = N;
+
+    constexpr void add(std::array<Type, N> row, Type value, Type weight = 1){
+        const auto scale = std::sqrt(weight);
+        for(auto &item : row){
+            item *= scale;
+        }
+        value *= scale;
+        for(size_t k = 0; k < N; ++k){
+            if(row[k] == Type{}){
+                continue;
+            }
+            const auto rkk = r_[k * N + k];
+            const auto radius = std::sqrt(rkk * rkk + row[k] * row[k]);
+            const auto c = rkk / radius;
+            const auto s = row[k] / radius;
+            r_[k * N + k] = radius;
+            for(size_t j = k + 1; j < N; ++j){
+                const auto rkj = r_[k * N + j];
+                r_[k * N + j] = c * rkj + s * row[j];
+                row[j] = c * row[j] - s * rkj;
+            }
+            const auto zk = z_[k];
+            z_[k] = c * zk + s * value;
+            value = c * value - s * zk;
+        }
+        //Остаток, не объяснимый моделью
+        residual_ += value * value;
+        ++count_;
+    }
+    constexpr void add(const vector<Type, N> &row, Type value, Type weight = 1){
+        std::array<Type, N> temp;
+        std::ranges::copy(row, temp.begin());
+        add(temp, value, weight);
+    }
+
+    //Забывание: вес накопленных наблюдений умножается на lambda (0 < lambda <= 1)
+    constexpr void forget(Type lambda){
+        const auto scale = std::sqrt(lambda);
+        for(auto &value : r_){
+            value *= scale;
+        }
+        for(auto &value : z_){
+            value *= scale;
+        }
+        residual_ *= lambda;
+    }
+
+    constexpr void clear(){
+        *this = least_squares_qr();
+    }
+    constexpr size_t size() const{
+        return count_;
+    }
+
+    constexpr std::optional<vector<Type, N>> solve() const{
+        const auto threshold = singular_threshold<Type, N>(r_);
+        vector<Type, N> temp(uninitialized);
+        auto x = temp.begin();
+        for(size_t i = N; i-- > 0;){
+            if(std::abs(r_[i * N + i]) <= threshold){
+                return std::nullopt;
+            }
+            auto value = z_[i];
+            for(size_t k = i + 1; k < N; ++k){
+                value -= r_[i * N + k] * x[k];
+            }
+            x[i] = value / r_[i * N + i];
+        }
+        return temp;
+    }
+
+    //Взвешенная сумма квадратов невязок решения МНК
+    constexpr Type residual() const{
+        return residual_;
+    }
+
+    //Треугольная матрица R (R^T R = A^T A)
+    constexpr matrix<Type, N, N> r() const{
+        return from_elements<matrix, Type, N, N>(r_);
+    }
+
+private:
+    std::array<Type, N * N> r_{};
+    std::array<Type, N> z_{};
+    Type residual_{};
+    size_t count_{};
+};
+
+//Решение переопределённой системы a * x = b по МНК (QR)
+template<std::floating_point Type, size_t M, size_t N> requires (M >= N)
+constexpr std::optional<matrix<Type, N, 1>> least_squares(const matrix<Type, M, N> &a, const matrix<Type, M, 1> &b){
+    least_squares_qr<Type, N> solver;
+    for(size_t i = 0; i < M; ++i){
+        std::array<Type, N> row;
+        for(size_t j = 0; j < N; ++j){
+            row[j] = a.value(i, j);
+        }
+        solver.add(row, b.value(i, 0));
+    }
+    const auto x = solver.solve();
+    if(!x){
+        return std::nullopt;
+    }
+    matrix<Type, N, 1> temp(uninitialized);
+    for(size_t i = 0; i < N; ++i){
+        temp.value(i, 0) = x->get(i);
+    }
+    return temp;
+}
+
+template<std::floating_point Type, size_t N>
+std::optional<vector<Type, N>> least_squares(const std::vector<std::array<Type, N>> &rows, const std::vector<Type> &values){
+    if(rows.size() != values.size()){
+        throw std::logic_error("least_squares: size mismatch");
+    }
+    least_squares_qr<Type, N> solver;
+    for(size_t i = 0; i < rows.size(); ++i){
+        solver.add(rows[i], values[i]);
+    }
+    return solver.solve();
+}
+
+}
+
+#endif // LEAST_SQUARES_ALGORITHM_H
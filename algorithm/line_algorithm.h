@@ -154,8 +154,9 @@ template<c_point2d_decard Point, std::floating_point TypeAngle,
          c_function_angle<typename Point::type_coordinate> ClassFunc = algorithm::function_angle<typename Point::type_coordinate>>
 constexpr auto equation_line_quick(const Point &point, TypeAngle direction)
     -> std::tuple<typename Point::type_coordinate, typename Point::type_coordinate, typename Point::type_coordinate>{
-    const auto a = -ClassFunc::cos(direction);
-    const auto b = ClassFunc::sin(direction);
+    const auto [sinDirection, cosDirection] = algorithm::sincos<ClassFunc>(static_cast<typename Point::type_coordinate>(direction));
+    const auto a = -cosDirection;
+    const auto b = sinDirection;
     return {a, b, algorithm::determine(-b, a, point.x(), point.y())};
 }
 
@@ -2,9 +2,12 @@
 #define MATRIX_ALGORITHM_H
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <numeric>
+#include <optional>
 #include <ranges>
+#include <stdexcept>
 
 #include "../iterator/matrix_iterator.h"
 #include "math_algorithm.h"
@@ -35,27 +38,148 @@ concept c_vector = requires(Type<T,N> temp){
     temp.end();
 };
 
+namespace agl{
+
+//Тег конструктора без заполнения элементов: для результатов, которые сразу перезаписываются целиком
+struct uninitialized_t{
+    explicit uninitialized_t() = default;
+};
+inline constexpr uninitialized_t uninitialized{};
+
+}
+
 namespace agl::matrix_algo{
 
+namespace {
+
+//Объект, все элементы которого записывает fill: без предварительного обнуления, если тип это позволяет.
+//Создание и заполнение в одной функции: вызов без аргументов GCC вычисляет на этапе компиляции и снова обнуляет
+template<typename Type, typename Func>
+constexpr Type make_filled(Func fill){
+    if constexpr(std::is_constructible_v<Type, uninitialized_t>){
+        Type temp(uninitialized);
+        fill(temp);
+        return temp;
+    }
+    else{
+        Type temp;
+        fill(temp);
+        return temp;
+    }
+}
+
+}
+
 template<template<typename, size_t, size_t> class Matrix, std::floating_point Type> requires c_matrix<Matrix, Type, 1,1>
 constexpr auto determinant(Matrix<Type,1,1> m) -> Matrix<Type,1,1>::type{
     return *m.begin();
 }
 
+//Элементы матрицы по строкам
+template<template<typename, size_t, size_t> class Matrix, typename Type, size_t R, size_t C> requires c_matrix<Matrix, Type, R, C>
+constexpr auto elements(const Matrix<Type, R, C> &m) -> std::array<Type, R * C>{
+    std::array<Type, R * C> temp;
+    std::ranges::copy(m, temp.begin());
+    return temp;
+}
+
+template<template<typename, size_t, size_t> class Matrix, typename Type, size_t R, size_t C> requires c_matrix<Matrix, Type, R, C>
+constexpr auto from_elements(const std::array<Type, R * C> &array) -> Matrix<Type, R, C>{
+    return make_filled<Matrix<Type, R, C>>([&array](auto &temp){
+        std::ranges::copy(array, temp.begin());
+    });
+}
+
+//Определители и присоединённые матрицы 2x2, 3x3 и 4x4 в замкнутой форме (элементы по строкам)
+template<std::floating_point Type>
+constexpr Type determinant(const std::array<Type, 4> &a){
+    return a[0] * a[3] - a[1] * a[2];
+}
+
+template<std::floating_point Type>
+constexpr Type determinant(const std::array<Type, 9> &a){
+    return a[0] * (a[4] * a[8] - a[5] * a[7])
+         - a[1] * (a[3] * a[8] - a[5] * a[6])
+         + a[2] * (a[3] * a[7] - a[4] * a[6]);
+}
+
+//Разложение Лапласа по двум верхним строкам: миноры 2x2 верхних (s) и нижних (c) строк
+template<std::floating_point Type>
+constexpr Type determinant(const std::array<Type, 16> &a){
+    const auto s0 = a[0] * a[5] - a[4] * a[1];
+    const auto s1 = a[0] * a[6] - a[4] * a[2];
+    const auto s2 = a[0] * a[7] - a[4] * a[3];
+    const auto s3 = a[1] * a[6] - a[5] * a[2];
+    const auto s4 = a[1] * a[7] - a[5] * a[3];
+    const auto s5 = a[2] * a[7] - a[6] * a[3];
+    const auto c5 = a[10] * a[15] - a[14] * a[11];
+    const auto c4 = a[9] * a[15] - a[13] * a[11];
+    const auto c3 = a[9] * a[14] - a[13] * a[10];
+    const auto c2 = a[8] * a[15] - a[12] * a[11];
+    const auto c1 = a[8] * a[14] - a[12] * a[10];
+    const auto c0 = a[8] * a[13] - a[12] * a[9];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+template<std::floating_point Type>
+constexpr std::array<Type, 4> adjugate(const std::array<Type, 4> &a){
+    return {a[3], -a[1],
+            -a[2], a[0]};
+}
+
+template<std::floating_point Type>
+constexpr std::array<Type, 9> adjugate(const std::array<Type, 9> &a){
+    return {a[4] * a[8] - a[5] * a[7], a[2] * a[7] - a[1] * a[8], a[1] * a[5] - a[2] * a[4],
+            a[5] * a[6] - a[3] * a[8], a[0] * a[8] - a[2] * a[6], a[2] * a[3] - a[0] * a[5],
+            a[3] * a[7] - a[4] * a[6], a[1] * a[6] - a[0] * a[7], a[0] * a[4] - a[1] * a[3]};
+}
+
+template<std::floating_point Type>
+constexpr std::array<Type, 16> adjugate(const std::array<Type, 16> &a){
+    const auto s0 = a[0] * a[5] - a[4] * a[1];
+    const auto s1 = a[0] * a[6] - a[4] * a[2];
+    const auto s2 = a[0] * a[7] - a[4] * a[3];
+    const auto s3 = a[1] * a[6] - a[5] * a[2];
+    const auto s4 = a[1] * a[7] - a[5] * a[3];
+    const auto s5 = a[2] * a[7] - a[6] * a[3];
+    const auto c5 = a[10] * a[15] - a[14] * a[11];
+    const auto c4 = a[9] * a[15] - a[13] * a[11];
+    const auto c3 = a[9] * a[14] - a[13] * a[10];
+    const auto c2 = a[8] * a[15] - a[12] * a[11];
+    const auto c1 = a[8] * a[14] - a[12] * a[10];
+    const auto c0 = a[8] * a[13] - a[12] * a[9];
+    return {a[5] * c5 - a[6] * c4 + a[7] * c3,    -a[1] * c5 + a[2] * c4 - a[3] * c3,
+            a[13] * s5 - a[14] * s4 + a[15] * s3, -a[9] * s5 + a[10] * s4 - a[11] * s3,
+            -a[4] * c5 + a[6] * c2 - a[7] * c1,   a[0] * c5 - a[2] * c2 + a[3] * c1,
+            -a[12] * s5 + a[14] * s2 - a[15] * s1, a[8] * s5 - a[10] * s2 + a[11] * s1,
+            a[4] * c4 - a[5] * c2 + a[7] * c0,    -a[0] * c4 + a[1] * c2 - a[3] * c0,
+            a[12] * s4 - a[13] * s2 + a[15] * s0, -a[8] * s4 + a[9] * s2 - a[11] * s0,
+            -a[4] * c3 + a[5] * c1 - a[6] * c0,   a[0] * c3 - a[1] * c1 + a[2] * c0,
+            -a[12] * s3 + a[13] * s1 - a[14] * s0, a[8] * s3 - a[9] * s1 + a[10] * s0};
+}
+
 template<template<typename, size_t, size_t> class Matrix, std::floating_point Type> requires c_matrix<Matrix, Type, 2,2>
 constexpr auto determinant(Matrix<Type,2,2> m) -> Matrix<Type,2,2>::type{
-    auto begin = m.begin();
-    auto end = m.end();
-    return (*begin) * (*std::prev(end)) - (*std::next(begin)) * (*std::prev(end,2));
+    return determinant(elements(m));
+}
+
+template<template<typename, size_t, size_t> class Matrix, std::floating_point Type> requires c_matrix<Matrix, Type, 3,3>
+constexpr auto determinant(const Matrix<Type,3,3> &m) -> Matrix<Type,3,3>::type{
+    return determinant(elements(m));
+}
+
+template<template<typename, size_t, size_t> class Matrix, std::floating_point Type> requires c_matrix<Matrix, Type, 4,4>
+constexpr auto determinant(const Matrix<Type,4,4> &m) -> Matrix<Type,4,4>::type{
+    return determinant(elements(m));
 }
 
 template<template<typename, size_t> class Vector, std::floating_point Type> requires c_vector<Vector, Type, 3>
 constexpr auto vector_product(const Vector<Type, 3> &vector_1, const Vector<Type, 3> &vector_2) -> Vector<Type, 3>{
-    Vector<Type, 3> temp;
-    std::ranges::transform(std::ranges::iota_view(0, 3), temp.begin(), [&vector_1,&vector_2](auto i){
-        return algorithm::determine(vector_1.get((i+1)%3), vector_1.get((i+2)%3), vector_2.get((i+1)%3), vector_2.get((i+2)%3));
+    return make_filled<Vector<Type, 3>>([&vector_1,&vector_2](auto &temp){
+        std::ranges::transform(std::ranges::iota_view(0, 3), temp.begin(), [&vector_1,&vector_2](auto i){
+            return algorithm::determine(vector_1.get((i+1)%3), vector_1.get((i+2)%3), vector_2.get((i+1)%3), vector_2.get((i+2)%3));
+        });
     });
-    return temp;
 }
 
 template<template<typename, size_t> class Vector, std::floating_point Type, size_t N> requires c_vector<Vector, Type, N>
@@ -158,18 +282,45 @@ constexpr auto determinant(Matrix<Type,N,N> m) -> Matrix<Type,N,N>::type{
     });
 }
 
+//out = m1 * m2 в существующую матрицу, out не должен совпадать с m1 или m2
 template<template<typename, size_t, size_t> class Matrix, typename Value1, typename Value2, size_t R1, size_t C1, size_t R2, size_t C2>
     requires c_matrix<Matrix, Value1, R1, C1> && c_matrix<Matrix, Value2, R2, C2> && (C1 == R2)
              && (std::is_floating_point_v<Value1> || std::is_integral_v<Value1>)
              && (std::is_floating_point_v<Value2> || std::is_integral_v<Value2>)
-constexpr auto mul(const Matrix<Value1, R1, C1> &m1, const Matrix<Value2, R2, C2> &m2) -> Matrix<Value1, R1, C2>{
-    Matrix<Value1, R1, C2> temp;
-    std::ranges::for_each(std::ranges::iota_view(size_t(), R1), [&temp,&m1,&m2](auto i){
-        std::ranges::transform(std::ranges::iota_view(size_t(), C2), temp.begin_column(i), [&m1,&m2,i](auto j){
-            return std::inner_product(m1.begin_column(i), m1.end_column(i), m2.begin_row(j), 0);
+constexpr void mul_into(const Matrix<Value1, R1, C1> &m1, const Matrix<Value2, R2, C2> &m2, Matrix<Value1, R1, C2> &out){
+    if((static_cast<const void*>(&out) == static_cast<const void*>(&m1)) || (static_cast<const void*>(&out) == static_cast<const void*>(&m2))){
+        throw std::logic_error("mul_into: output aliases input");
+    }
+    std::ranges::for_each(std::ranges::iota_view(size_t(), R1), [&out,&m1,&m2](auto i){
+        std::ranges::transform(std::ranges::iota_view(size_t(), C2), out.begin_column(i), [&m1,&m2,i](auto j){
+            return std::inner_product(m1.begin_column(i), m1.end_column(i), m2.begin_row(j), Value1{});
         });
     });
-    return temp;
+}
+
+template<template<typename, size_t, size_t> class Matrix, typename Value1, typename Value2, size_t R1, size_t C1, size_t R2, size_t C2>
+    requires c_matrix<Matrix, Value1, R1, C1> && c_matrix<Matrix, Value2, R2, C2> && (C1 == R2)
+             && (std::is_floating_point_v<Value1> || std::is_integral_v<Value1>)
+             && (std::is_floating_point_v<Value2> || std::is_integral_v<Value2>)
+constexpr auto mul(const Matrix<Value1, R1, C1> &m1, const Matrix<Value2, R2, C2> &m2) -> Matrix<Value1, R1, C2>{
+    return make_filled<Matrix<Value1, R1, C2>>([&m1,&m2](auto &temp){
+        mul_into(m1, m2, temp);
+    });
+}
+
+//out = m1 * m2 в существующий вектор, out не должен совпадать с m2
+template<template<typename, size_t, size_t> class Matrix, template<typename, size_t> class Vector,
+         typename Value1, typename Value2, size_t R>
+    requires c_matrix<Matrix, Value1, R, R> && c_vector<Vector, Value2, R>
+             && (std::is_floating_point_v<Value1> || std::is_integral_v<Value1>)
+             && (std::is_floating_point_v<Value2> || std::is_integral_v<Value2>)
+constexpr void mul_into(const Matrix<Value1, R, R> &m1, const Vector<Value2, R> &m2, Vector<Value2, R> &out){
+    if(static_cast<const void*>(&out) == static_cast<const void*>(&m2)){
+        throw std::logic_error("mul_into: output aliases input");
+    }
+    std::ranges::transform(std::ranges::iota_view(size_t(), R), out.begin(), [&m1,&m2](auto j){
+        return std::inner_product(m1.begin_column(j), m1.end_column(j), m2.begin(), Value2{});
+    });
 }
 
 template<template<typename, size_t, size_t> class Matrix, template<typename, size_t> class Vector,
@@ -178,11 +329,9 @@ template<template<typename, size_t, size_t> class Matrix, template<typename, siz
              && (std::is_floating_point_v<Value1> || std::is_integral_v<Value1>)
              && (std::is_floating_point_v<Value2> || std::is_integral_v<Value2>)
 constexpr auto mul(const Matrix<Value1, R, R> &m1, const Vector<Value2, R> &m2) -> Vector<Value2, R>{
-    Vector<Value2, R> temp;
-    std::ranges::transform(std::ranges::iota_view(size_t(), R), temp.begin(), [&m1,&m2](auto j){
-        return std::inner_product(m1.begin_column(j), m1.end_column(j), m2.begin(), 0);
+    return make_filled<Vector<Value2, R>>([&m1,&m2](auto &temp){
+        mul_into(m1, m2, temp);
     });
-    return temp;
 }
 
 template<typename Type, size_t N>
@@ -196,14 +345,43 @@ constexpr auto mul(const std::array<Type, N * N> &matrix, const std::array<Type,
     return temp;
 }
 
+//Транспонирование в существующую матрицу. Для квадратной матрицы out может совпадать с matrix
+template<template<typename, size_t, size_t> class Matrix, typename Value, size_t R, size_t C>
+    requires c_matrix<Matrix, Value, R, C> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>)
+constexpr void transpose_into(const Matrix<Value, R, C> &matrix, Matrix<Value, C, R> &out){
+    if constexpr(R == C){
+        //Транспонирование на месте
+        if(&matrix == &out){
+            for(size_t i = 0; i < R; ++i){
+                std::swap_ranges(std::next(out.begin_column(i), i + 1), out.end_column(i), std::next(out.begin_row(i), i + 1));
+            }
+            return;
+        }
+    }
+    std::ranges::for_each(std::ranges::iota_view(size_t{}, R), [&matrix, &out](const auto &i){
+        std::ranges::copy(matrix.cbegin_column(i), matrix.cend_column(i), out.begin_row(i));
+    });
+}
+
 template<template<typename, size_t, size_t> class Matrix, typename Value, size_t R, size_t C>
     requires c_matrix<Matrix, Value, R, C> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>)
 constexpr auto transposed(const Matrix<Value, R, C> &matrix) -> Matrix<Value,C,R>{
-    Matrix<Value,C,R> temp;
-    std::ranges::for_each(std::ranges::iota_view(size_t{}, R), [&matrix, &temp](const auto &i){
-        std::ranges::copy(matrix.cbegin_column(i), matrix.cend_column(i), temp.begin_row(i));
+    return make_filled<Matrix<Value, C, R>>([&matrix](auto &temp){
+        transpose_into(matrix, temp);
     });
-    return temp;
+}
+
+//out = m1 + m2 и out = m1 - m2 поэлементно, out может совпадать с m1 или m2
+template<template<typename, size_t, size_t> class Matrix, typename Value, size_t R, size_t C>
+    requires c_matrix<Matrix, Value, R, C> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>)
+constexpr void add_into(const Matrix<Value, R, C> &m1, const Matrix<Value, R, C> &m2, Matrix<Value, R, C> &out){
+    std::transform(m1.begin(), m1.end(), m2.begin(), out.begin(), std::plus{});
+}
+
+template<template<typename, size_t, size_t> class Matrix, typename Value, size_t R, size_t C>
+    requires c_matrix<Matrix, Value, R, C> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>)
+constexpr void sub_into(const Matrix<Value, R, C> &m1, const Matrix<Value, R, C> &m2, Matrix<Value, R, C> &out){
+    std::transform(m1.begin(), m1.end(), m2.begin(), out.begin(), std::minus{});
 }
 
 template<template<typename, size_t, size_t>  class Matrix, typename Value, size_t N>
@@ -219,36 +397,67 @@ constexpr auto identity_matrix() -> Matrix<Value,N,N>{
 template<template<typename, size_t, size_t>  class Matrix, typename Value, size_t N>
     requires c_matrix<Matrix, Value, N, N> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>) && (N > 1)
 constexpr auto minor(const Matrix<Value,N,N> &matrix, size_t row, size_t column) -> Matrix<Value,N-1,N-1>{
-    Matrix<Value, N-1, N-1> temp;
     auto numbers = std::ranges::iota_view(size_t(), N * N) | std::ranges::views::filter([row,column](const auto &i){
         return (i % N != column) && !algorithm::interval_left_strict(i, row * N, (row + 1) * N);
     });
-    std::ranges::transform(numbers, temp.begin(), [&matrix](auto i){
-        return *std::next(matrix.begin(), i);
+    return make_filled<Matrix<Value, N-1, N-1>>([&matrix, &numbers](auto &temp){
+        std::ranges::transform(numbers, temp.begin(), [&matrix](auto i){
+            return matrix.begin()[i];
+        });
     });
-    return temp;
 }
 
 template<template<typename, size_t, size_t>  class Matrix, typename Value, size_t N>
     requires c_matrix<Matrix, Value, N, N> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>) && (N > 1)
 constexpr auto matrix_algebraic_additions(const Matrix<Value, N, N> &matrix){
-    Matrix<Value, N, N> temp;
-    std::ranges::transform(std::ranges::iota_view(size_t(), N * N), temp.begin(), [&matrix](auto i){
-        int sign = (i % 2 == 0) ? 1 : -1;
-        return sign * determinant(minor(matrix, i / N, i % N));
-    });
-    return temp;
+    if constexpr(N <= 4){
+        return transposed(from_elements<Matrix, Value, N, N>(adjugate(elements(matrix))));
+    }
+    else{
+        return make_filled<Matrix<Value, N, N>>([&matrix](auto &temp){
+            std::ranges::transform(std::ranges::iota_view(size_t(), N * N), temp.begin(), [&matrix](auto i){
+                int sign = ((i / N + i % N) % 2 == 0) ? 1 : -1;
+                return sign * determinant(minor(matrix, i / N, i % N));
+            });
+        });
+    }
 }
 
+//Присоединённая матрица (транспонированная матрица алгебраических дополнений)
+template<template<typename, size_t, size_t>  class Matrix, typename Value, size_t N>
+    requires c_matrix<Matrix, Value, N, N> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>) && (N > 1)
+constexpr auto adjugate(const Matrix<Value, N, N> &matrix) -> Matrix<Value, N, N>{
+    if constexpr(N <= 4){
+        return from_elements<Matrix, Value, N, N>(adjugate(elements(matrix)));
+    }
+    else{
+        return transposed(matrix_algebraic_additions(matrix));
+    }
+}
 
 template<template<typename, size_t, size_t>  class Matrix, typename Value, size_t N>
     requires c_matrix<Matrix, Value, N, N> && (std::is_floating_point_v<Value> || std::is_integral_v<Value>) && (N > 1)
 constexpr auto inverse_matrix(const Matrix<Value, N, N> &matrix) -> std::optional<Matrix<Value, N, N>>{
-    auto det = determinant(matrix);
-    if(algorithm::compare(det, 0)){
-        return std::nullopt;
+    if constexpr(N <= 4){
+        auto temp = elements(matrix);
+        const auto det = determinant(temp);
+        if(algorithm::compare(det, 0)){
+            return std::nullopt;
+        }
+        const auto k = 1 / det;
+        temp = adjugate(temp);
+        std::ranges::transform(temp, temp.begin(), [k](const auto &item){
+            return item * k;
+        });
+        return from_elements<Matrix, Value, N, N>(temp);
+    }
+    else{
+        auto det = determinant(matrix);
+        if(algorithm::compare(det, 0)){
+            return std::nullopt;
+        }
+        return (1.0 / det) * adjugate(matrix);
     }
-    return (1.0 / det) * transposed(matrix_algebraic_additions(matrix));
 }
 
 template<template<typename, size_t, size_t>  class Matrix, typename Value, size_t R, size_t C>
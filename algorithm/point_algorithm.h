@@ -28,7 +28,8 @@ constexpr auto distance(const Point &point1, const Point &point2){
 template<c_point2d_decard Point, std::floating_point TypeAngle, std::floating_point TypeRange,
          c_function_angle<typename Point::type_coordinate> ClassFunc = algorithm::function_angle<typename Point::type_coordinate>>
 constexpr Point new_point(const Point &point, const TypeAngle &angle, const TypeRange &range){
-    return {point.x() + range * ClassFunc::sin(angle), point.y() + range * ClassFunc::cos(angle)};
+    const auto [sinAngle, cosAngle] = algorithm::sincos<ClassFunc>(static_cast<typename Point::type_coordinate>(angle));
+    return {point.x() + range * sinAngle, point.y() + range * cosAngle};
 }
 
 //метод преобразует текущие координаты относительно заданной точки и угла поворота
@@ -36,8 +37,8 @@ template<c_point2d_decard Point, std::floating_point TypeAngle,
          c_function_angle<typename Point::type_coordinate> ClassFunc = algorithm::function_angle<typename Point::type_coordinate>>
 constexpr Point rotate(const Point &point, const TypeAngle &angle, const Point &reference){
     using Type = Point::type_coordinate;
-    const auto sinAngle = -ClassFunc::sin(angle);
-    const auto cosAngle = ClassFunc::cos(angle);
+    auto [sinAngle, cosAngle] = algorithm::sincos<ClassFunc>(static_cast<Type>(angle));
+    sinAngle = -sinAngle;
     auto vector = matrix_algo::mul<Type, 2>({cosAngle, -sinAngle, sinAngle, cosAngle},
                                             {point.x() - reference.x(), point.y() - reference.y()});
     return {vector[0] + reference.x(), vector[1] + reference.y()};
@@ -0,0 +1,778 @@
+#ifndef PROJECTION_ALGORITHM_H
+#define PROJECTION_ALGORITHM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "math_algorithm.h"
+#include "../structs/ellipsoid_impl.h"
+#include "../structs/geo_box_impl.h"
+#include "../system/system_concept.h"
+
+namespace agl::projection_algo {
+
+//Коэффициенты рядов Крюгера до n^6 (n - третье сжатие). Погрешность прямого и обратного преобразований
+//не превышает нескольких нанометров в полосе до 4000 км от осевого меридиана
+template<std::floating_point Type, c_ellipsoid Ellipsoid>
+struct kruger_series{
+    static constexpr Type n = Ellipsoid::flattening / (2 - Ellipsoid::flattening);
+    static constexpr Type n2 = n * n;
+    static constexpr Type n3 = n2 * n;
+    static constexpr Type n4 = n3 * n;
+    static constexpr Type n5 = n4 * n;
+    static constexpr Type n6 = n5 * n;
+
+    //!Радиус спрямляющей сферы: длина дуги меридиана на единицу угла
+    static constexpr Type rectifying_radius = Ellipsoid::semimajor_axis / (1 + n) * (1 + n2 / 4 + n4 / 64 + n6 / 256);
+
+    //!Коэффициенты прямого преобразования (конформная широта -> плоские координаты)
+    static constexpr std::array<Type, 6> alpha{
+        n / 2 - 2 * n2 / 3 + 5 * n3 / 16 + 41 * n4 / 180 - 127 * n5 / 288 + 7891 * n6 / 37800,
+        13 * n2 / 48 - 3 * n3 / 5 + 557 * n4 / 1440 + 281 * n5 / 630 - 1983433 * n6 / 1935360,
+        61 * n3 / 240 - 103 * n4 / 140 + 15061 * n5 / 26880 + 167603 * n6 / 181440,
+        49561 * n4 / 161280 - 179 * n5 / 168 + 6601661 * n6 / 7257600,
+        34729 * n5 / 80640 - 3418889 * n6 / 1995840,
+        212378941 * n6 / 319334400};
+
+    //!Коэффициенты обратного преобразования
+    static constexpr std::array<Type, 6> beta{
+        n / 2 - 2 * n2 / 3 + 37 * n3 / 96 - n4 / 360 - 81 * n5 / 512 + 96199 * n6 / 604800,
+        n2 / 48 + n3 / 15 - 437 * n4 / 1440 + 46 * n5 / 105 - 1118711 * n6 / 3870720,
+        17 * n3 / 480 - 37 * n4 / 840 - 209 * n5 / 4480 + 5569 * n6 / 90720,
+        4397 * n4 / 161280 - 11 * n5 / 504 - 830251 * n6 / 7257600,
+        4583 * n5 / 161280 - 108847 * n6 / 3991680,
+        20648693 * n6 / 638668800};
+};
+
+namespace {
+
+//Сумма sum(c[j] * sin(2 * (j + 1) * z)) комплексного аргумента z = xi + i * eta по схеме Кленшоу.
+//На вход подаются sin(2xi), cos(2xi), sinh(2eta), cosh(2eta), результат - действительная и мнимая части.
+//Шаги развёрнуты при компиляции: в пакетном ядре внутренний цикл мешает векторизации
+template<std::floating_point Type, size_t... J>
+[[gnu::always_inline]] constexpr std::pair<Type, Type> clenshaw(const std::array<Type, sizeof...(J)> &c, Type ar, Type ai,
+                                                                std::index_sequence<J...>){
+    Type yr0{}, yi0{}, yr1{}, yi1{}, yr{}, yi{};
+    ((yr = c[c.size() - 1 - J] + ar * yr0 - ai * yi0 - yr1,
+      yi = ar * yi0 + ai * yr0 - yi1,
+      yr1 = yr0, yi1 = yi0, yr0 = yr, yi0 = yi), ...);
+    return {yr0, yi0};
+}
+
+template<std::floating_point Type>
+[[gnu::always_inline]] constexpr std::pair<Type, Type> clenshaw(const std::array<Type, 6> &c, Type sin2, Type cos2, Type sinh2,
+                                                                Type cosh2){
+    //2 * cos(2z)
+    const auto [yr0, yi0] = clenshaw(c, 2 * cos2 * cosh2, -2 * sin2 * sinh2, std::make_index_sequence<6>());
+    //b1 * sin(2z)
+    const auto sr = sin2 * cosh2;
+    const auto si = cos2 * sinh2;
+    return {yr0 * sr - yi0 * si, yr0 * si + yi0 * sr};
+}
+
+//Приведение разности долгот к [-pi, pi)
+template<std::floating_point Type>
+constexpr Type normalize_longitude(Type longitude){
+    return longitude - algorithm::pi_in_2<Type> * std::floor((longitude + algorithm::pi<Type>) / algorithm::pi_in_2<Type>);
+}
+
+//Функции пакетного ядра: в double, без ветвлений и вызовов libm, чтобы цикл по точкам векторизовался (в том числе
+//для базового SSE2). Выбор допускается только между двумя константами, ни одна из которых не упрощает выражение
+//(не 0 и не 1): иначе компилятор расщепляет путь на ветви и отказывается от векторизации. Округление до целого -
+//прибавлением и вычитанием 1.5 * 2^52 (не работает с -ffast-math)
+
+//Многочлен по схеме Горнера, коэффициенты от старшей степени к младшей; шаги развёрнуты при компиляции.
+//Функции ядра встраиваются принудительно: эвристика встраивания отказывает в редко вызываемом коде, и цикл не векторизуется
+template<size_t N, size_t... I>
+[[gnu::always_inline]] inline double batch_horner(const std::array<double, N> &c, double x, std::index_sequence<I...>){
+    auto result = c[0];
+    ((result = result * x + c[I + 1]), ...);
+    return result;
+}
+
+template<size_t N>
+[[gnu::always_inline]] inline double batch_horner(const std::array<double, N> &c, double x){
+    return batch_horner(c, x, std::make_index_sequence<N - 1>());
+}
+
+//Ближайшее целое при |x| < 2^51 и биты суммы x + 1.5 * 2^52, в младших разрядах которых это целое в дополнительном коде
+[[gnu::always_inline]] inline std::pair<double, std::uint64_t> batch_round(double x){
+    constexpr double shifter = 6755399441055744.;
+    const auto shifted = x + shifter;
+    return {shifted - shifter, std::bit_cast<std::uint64_t>(shifted)};
+}
+
+//Целое k, прижатое к [low, high], без сравнений: (|k - low| - |k - high| + low + high) / 2 точно для |k| < 2^51
+[[gnu::always_inline]] inline double batch_clamp(double k, double low, double high){
+    return 0.5 * (std::abs(k - low) - std::abs(k - high) + (low + high));
+}
+
+//2^k для целого k в [-1022, 1023]: показатель собирается из битов
+[[gnu::always_inline]] inline double batch_power2(double k){
+    return std::bit_cast<double>((batch_round(k).second + 1023) << 52);
+}
+
+//sqrt: приближение 1/sqrt(x) по битам, четыре итерации Ньютона и поправка, погрешность до 1 ULP.
+//std::sqrt при -fmath-errno (по умолчанию) содержит ветвь с вызовом libm для отрицательного аргумента
+[[gnu::always_inline]] inline double batch_sqrt(double x){
+    auto y = std::bit_cast<double>(0x5fe6eb50c7b537a9 - (std::bit_cast<std::uint64_t>(x) >> 1));
+    y = y * (1.5 - 0.5 * x * y * y);
+    y = y * (1.5 - 0.5 * x * y * y);
+    y = y * (1.5 - 0.5 * x * y * y);
+    y = y * (1.5 - 0.5 * x * y * y);
+    const auto s = x * y;
+    return s + 0.5 * y * (x - s * s);
+}
+
+//e^x при |x| < 1e15: x = k * ln2 + r, |r| <= ln2 / 2, ряд Тейлора до r^13.
+//2^k = 2^k1 * 2^(k - k1), показатели прижаты к [-1022, 1023]: за пределами double результат - 0 или бесконечность
+[[gnu::always_inline]] inline double batch_exp(double x){
+    constexpr auto series = []{
+        std::array<double, 14> c{};
+        double factorial = 1;
+        for(size_t i = 0; i < c.size(); ++i){
+            factorial *= (i == 0) ? 1 : double(i);
+            c[c.size() - 1 - i] = 1 / factorial;
+        }
+        return c;
+    }();
+    const auto k = batch_round(x * std::numbers::log2e).first;
+    const auto r = (x - k * 6.93145751953125e-1) - k * 1.42860682030941723212e-6;
+    const auto k1 = batch_clamp(k, -1022., 1023.);
+    return batch_horner(series, r) * batch_power2(k1) * batch_power2(batch_clamp(k - k1, -1022., 1023.));
+}
+
+//atanh(x) = x + x^3/3 + ... + x^23/23, погрешность <= 1 ULP при |x| <= 0.18
+[[gnu::always_inline]] inline double batch_atanh(double x){
+    constexpr auto series = []{
+        std::array<double, 11> c{};
+        for(size_t i = 0; i < c.size(); ++i){
+            c[i] = 1. / double(2 * (c.size() - i) + 1);
+        }
+        return c;
+    }();
+    const auto z = x * x;
+    return x + x * z * batch_horner(series, z);
+}
+
+//sinh(x) при |x| <= 0.03 (поправка конформной широты)
+[[gnu::always_inline]] inline double batch_sinh_small(double x){
+    const auto z = x * x;
+    return x + x * z * batch_horner(std::array{1. / 362880., 1. / 5040., 1. / 120., 1. / 6.}, z);
+}
+
+//Натуральный логарифм положительного нормализованного x: x = m * 2^e, m в [0.705, 1.41), ln(m) = 2 atanh((m - 1) / (m + 1)).
+//Разбиение по битам со сдвигом границы (как в musl): показатель e смещён на 1024, чтобы сдвиг был логическим,
+//и переводится в double через биты числа 2^52 + e
+[[gnu::always_inline]] inline double batch_log(double x){
+    const auto bits = std::bit_cast<std::uint64_t>(x);
+    const auto shifted = bits - 0x3fe6955500000000 + 0x4000000000000000;
+    const auto m = std::bit_cast<double>(bits - (shifted & 0xfff0000000000000) + 0x4000000000000000);
+    const auto e = std::bit_cast<double>((shifted >> 52) | 0x4330000000000000) - 4503599627371520.;
+    return e * 6.93145751953125e-1 + (2 * batch_atanh((m - 1) / (m + 1)) + e * 1.42860682030941723212e-6);
+}
+
+[[gnu::always_inline]] inline double batch_asinh(double x){
+    const auto a = std::abs(x);
+    return std::copysign(batch_log(a + batch_sqrt(a * a + 1)), x);
+}
+
+//sin и cos при |x| <= 1e5, приведение и многочлены как в fast_function_angle.
+//Четверть выбирается масками по младшим битам k: нечётная меняет sin и cos местами, знак - по биту 2
+[[gnu::always_inline]] inline std::pair<double, double> batch_sincos(double x){
+    const auto [k, bits] = batch_round(x * 0.63661977236758134308);
+    const auto r = ((x - k * 1.57079625129699707031) - k * 7.54978941586159635336e-8) - k * 5.39030285815811905290e-15;
+    const auto z = r * r;
+    const auto sin_r = r + r * z * batch_horner(std::array{1.58962301576546568060e-10, -2.50507477628578072866e-8,
+                                                           2.75573136213857245213e-6, -1.98412698295895385996e-4,
+                                                           8.33333333332211858878e-3, -1.66666666666666307295e-1}, z);
+    const auto cos_r = 1 - 0.5 * z + z * z * batch_horner(std::array{-1.13585365213876817300e-11, 2.08757008419747316778e-9,
+                                                                     -2.75573141792967388112e-7, 2.48015872888517045348e-5,
+                                                                     -1.38888888888730564116e-3, 4.16666666666665929218e-2}, z);
+    const auto sin_bits = std::bit_cast<std::uint64_t>(sin_r);
+    const auto cos_bits = std::bit_cast<std::uint64_t>(cos_r);
+    const auto swap = std::uint64_t{} - (bits & 1);
+    return {std::bit_cast<double>(((sin_bits & ~swap) | (cos_bits & swap)) ^ ((bits & 2) << 62)),
+            std::bit_cast<double>(((cos_bits & ~swap) | (sin_bits & swap)) ^ (((bits + 1) & 2) << 62))};
+}
+
+//atan2 с абсолютной погрешностью до 4e-16: t = min(|x|, |y|) / max(|x|, |y|) в [0, 1] сдвигается на tan(pi/8):
+//atan(t) = pi/8 + atan((t - c) / (1 + c t)), аргумент в [-c, c], рациональное приближение Cephes.
+//Октант восстанавливается отражениями a -> 2m - a с множителем +-2 (не +-1, см. выше)
+[[gnu::always_inline]] inline double batch_atan2(double y, double x){
+    constexpr double c = 0.41421356237309504880;
+    const auto ax = std::abs(x);
+    const auto ay = std::abs(y);
+    const auto t = std::min(ax, ay) / std::max(std::max(ax, ay), std::numeric_limits<double>::min());
+    const auto u = (t - c) / (1 + c * t);
+    const auto z = u * u;
+    const auto p = batch_horner(std::array{-8.750608600031904122785e-1, -1.615753718733365076637e1, -7.500855792314704667340e1,
+                                           -1.228866684490136173410e2, -6.485021904942025371773e1}, z);
+    const auto q = batch_horner(std::array{1., 2.485846490142306297962e1, 1.650270098316988542046e2, 4.328810604912902668951e2,
+                                           4.853903996359136964868e2, 1.945506571482613964425e2}, z);
+    const auto a = algorithm::pi<double> / 8 + (u + u * z * p / q);
+    const auto b = algorithm::pi_on_4<double> + 0.5 * ((ay > ax) ? -2. : 2.) * (a - algorithm::pi_on_4<double>);
+    return std::copysign(algorithm::pi_on_2<double> + 0.5 * ((x < 0) ? -2. : 2.) * (b - algorithm::pi_on_2<double>), y);
+}
+
+}
+
+//Поперечная проекция Меркатора (Гаусса-Крюгера) на ряде Крюгера. x - восток (easting), y - север (northing).
+//Параметры проекции задаются явно: осевой меридиан (радианы), масштаб на осевом меридиане и ложные сдвиги.
+//Пакетные функции работают с раздельными массивами координат. Для float и double точки считает ядро без ветвлений
+//и вызовов libm (функции batch_*), которое компилятор векторизует (-O3); политика ClassFunc в нём не используется
+//По умолчанию эллипсоид WGS84 и параметры UTM: на нём определена система UTM
+template<std::floating_point Type,
+         c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>,
+         c_ellipsoid Ellipsoid = wgs84<Type>>
+class transverse_mercator{
+public:
+    using series = kruger_series<Type, Ellipsoid>;
+
+    //!Число итераций Ньютона при восстановлении широты из конформной (сходимость до ULP за 2)
+    static constexpr int iterations = 3;
+
+    explicit transverse_mercator(Type central_meridian, Type scale = 0.9996, Type false_easting = 500'000.,
+                                 Type false_northing = 0.)
+        : central_meridian_(central_meridian), scale_(scale), false_easting_(false_easting), false_northing_(false_northing),
+          eccentricity_(std::sqrt(static_cast<Type>(Ellipsoid::eccentricity2))), radius_(scale * series::rectifying_radius){}
+
+    Type central_meridian() const{
+        return central_meridian_;
+    }
+    Type scale() const{
+        return scale_;
+    }
+    Type false_easting() const{
+        return false_easting_;
+    }
+    Type false_northing() const{
+        return false_northing_;
+    }
+
+    //Прямое преобразование: {easting, northing}
+    std::pair<Type, Type> forward(Type latitude, Type longitude) const{
+        const auto lambda = normalize_longitude(longitude - central_meridian_);
+        const auto tau = ClassFunc::tan(latitude);
+        const auto [sin_lambda, cos_lambda] = algorithm::sincos<ClassFunc>(lambda);
+        //Тангенс конформной широты
+        const auto root = std::sqrt(1 + tau * tau);
+        const auto sigma = std::sinh(eccentricity_ * std::atanh(eccentricity_ * tau / root));
+        const auto taup = tau * std::sqrt(1 + sigma * sigma) - sigma * root;
+        //Координаты на сфере (поперечная проекция Меркатора сферы)
+        const auto xip = ClassFunc::atan2(taup, cos_lambda);
+        const auto etap = std::asinh(sin_lambda / std::sqrt(taup * taup + cos_lambda * cos_lambda));
+        const auto [sin2, cos2] = algorithm::sincos<ClassFunc>(2 * xip);
+        const auto [dxi, deta] = clenshaw(series::alpha, sin2, cos2, std::sinh(2 * etap), std::cosh(2 * etap));
+        return {false_easting_ + radius_ * (etap + deta), false_northing_ + radius_ * (xip + dxi)};
+    }
+
+    //Обратное преобразование: {latitude, longitude}
+    std::pair<Type, Type> inverse(Type easting, Type northing) const{
+        const auto xi = (northing - false_northing_) / radius_;
+        const auto eta = (easting - false_easting_) / radius_;
+        const auto [sin2, cos2] = algorithm::sincos<ClassFunc>(2 * xi);
+        const auto [dxi, deta] = clenshaw(series::beta, sin2, cos2, std::sinh(2 * eta), std::cosh(2 * eta));
+        const auto xip = xi - dxi;
+        const auto etap = eta - deta;
+        const auto [sin_xip, cos_xip] = algorithm::sincos<ClassFunc>(xip);
+        const auto sinh_etap = std::sinh(etap);
+        const auto taup = sin_xip / std::sqrt(sinh_etap * sinh_etap + cos_xip * cos_xip);
+        const auto lambda = ClassFunc::atan2(sinh_etap, cos_xip);
+        return {ClassFunc::atan(conformal_inverse(taup)), normalize_longitude(central_meridian_ + lambda)};
+    }
+
+    template<c_point2d_decard Point, c_point2d_geo PointGeo>
+    Point forward(const PointGeo &point) const{
+        const auto [x, y] = forward(static_cast<Type>(point.latitude()), static_cast<Type>(point.longitude()));
+        return Point(x, y);
+    }
+
+    template<c_point2d_geo PointGeo, c_point2d_decard Point>
+    PointGeo inverse(const Point &point) const{
+        const auto [latitude, longitude] = inverse(static_cast<Type>(point.x()), static_cast<Type>(point.y()));
+        return PointGeo(latitude, longitude);
+    }
+
+    //Пакетное прямое преобразование массивов широт и долгот в массивы easting и northing.
+    //Для float и double точки считаются ядром batch_forward, для long double - точечным преобразованием
+    void forward(std::span<const Type> latitude, std::span<const Type> longitude, std::span<Type> easting,
+                 std::span<Type> northing) const{
+        check_size(latitude.size(), longitude.size(), easting.size(), northing.size());
+        if constexpr(batch_kernel){
+            const auto parameters = batch_parameters();
+            for(size_t i = 0; i < latitude.size(); ++i){
+                const auto [x, y] = batch_forward(parameters, latitude[i], longitude[i]);
+                easting[i] = static_cast<Type>(x);
+                northing[i] = static_cast<Type>(y);
+            }
+        }
+        else{
+            for(size_t i = 0; i < latitude.size(); ++i){
+                const auto [x, y] = forward(latitude[i], longitude[i]);
+                easting[i] = x;
+                northing[i] = y;
+            }
+        }
+    }
+
+    //Пакетное обратное преобразование
+    void inverse(std::span<const Type> easting, std::span<const Type> northing, std::span<Type> latitude,
+                 std::span<Type> longitude) const{
+        check_size(easting.size(), northing.size(), latitude.size(), longitude.size());
+        if constexpr(batch_kernel){
+            const auto parameters = batch_parameters();
+            for(size_t i = 0; i < easting.size(); ++i){
+                const auto [lat, lon] = batch_inverse(parameters, easting[i], northing[i]);
+                latitude[i] = static_cast<Type>(lat);
+                longitude[i] = static_cast<Type>(lon);
+            }
+        }
+        else{
+            for(size_t i = 0; i < easting.size(); ++i){
+                const auto [lat, lon] = inverse(easting[i], northing[i]);
+                latitude[i] = lat;
+                longitude[i] = lon;
+            }
+        }
+    }
+
+    template<c_point2d_decard Point, c_point2d_geo PointGeo>
+    std::vector<Point> forward(const std::vector<PointGeo> &points) const{
+        std::vector<Point> temp;
+        temp.reserve(points.size());
+        for(const auto &point : points){
+            temp.push_back(forward<Point>(point));
+        }
+        return temp;
+    }
+
+    template<c_point2d_geo PointGeo, c_point2d_decard Point>
+    std::vector<PointGeo> inverse(const std::vector<Point> &points) const{
+        std::vector<PointGeo> temp;
+        temp.reserve(points.size());
+        for(const auto &point : points){
+            temp.push_back(inverse<PointGeo>(point));
+        }
+        return temp;
+    }
+
+private:
+    //Тангенс широты по тангенсу конформной широты (метод Ньютона с фиксированным числом шагов)
+    Type conformal_inverse(Type taup) const{
+        constexpr auto e2m = 1 - static_cast<Type>(Ellipsoid::eccentricity2);
+        auto tau = taup / e2m;
+        for(int i = 0; i < iterations; ++i){
+            const auto root = std::sqrt(1 + tau * tau);
+            const auto sigma = std::sinh(eccentricity_ * std::atanh(eccentricity_ * tau / root));
+            const auto taupa = tau * std::sqrt(1 + sigma * sigma) - sigma * root;
+            tau += (taup - taupa) * (1 + e2m * tau * tau) / (e2m * root * std::sqrt(1 + taupa * taupa));
+        }
+        return tau;
+    }
+
+    static void check_size(size_t size1, size_t size2, size_t size3, size_t size4){
+        if((size1 != size2) || (size3 < size1) || (size4 < size1)){
+            throw std::logic_error("transverse_mercator: size mismatch");
+        }
+    }
+
+    //!Пакетное ядро: float и double, ряд batch_atanh сходится при эксцентриситете до 0.17
+    static constexpr bool batch_kernel = !std::is_same_v<Type, long double> && (Ellipsoid::eccentricity2 < 0.029);
+
+    //Параметры проекции в локальной копии: запись в выходные массивы не заставляет перечитывать поля объекта
+    struct batch_parameter{
+        double central_meridian;
+        double eccentricity;
+        double radius;
+        double false_easting;
+        double false_northing;
+    };
+
+    batch_parameter batch_parameters() const{
+        return {central_meridian_, eccentricity_, radius_, false_easting_, false_northing_};
+    }
+
+    //Поправка конформной широты tau' - tau (sigma в обозначениях Карни)
+    [[gnu::always_inline]] static double batch_sigma(double eccentricity, double tau, double root){
+        return batch_sinh_small(eccentricity * batch_atanh(eccentricity * tau / root));
+    }
+
+    //Точечное преобразование на функциях batch_*: те же формулы, что в forward(latitude, longitude)
+    [[gnu::always_inline]] static std::pair<double, double> batch_forward(const batch_parameter &p, double latitude, double longitude){
+        using series = kruger_series<double, Ellipsoid>;
+        const auto delta = longitude - p.central_meridian;
+        const auto lambda = delta - algorithm::pi_in_2<double> * batch_round(delta / algorithm::pi_in_2<double>).first;
+        const auto [sin_latitude, cos_latitude] = batch_sincos(latitude);
+        const auto tau = sin_latitude / cos_latitude;
+        const auto root = batch_sqrt(1 + tau * tau);
+        const auto sigma = batch_sigma(p.eccentricity, tau, root);
+        const auto taup = tau * batch_sqrt(1 + sigma * sigma) - sigma * root;
+        const auto [sin_lambda, cos_lambda] = batch_sincos(lambda);
+        const auto xip = batch_atan2(taup, cos_lambda);
+        const auto etap = batch_asinh(sin_lambda / batch_sqrt(taup * taup + cos_lambda * cos_lambda));
+        const auto [sin2, cos2] = batch_sincos(2 * xip);
+        const auto exp2 = batch_exp(2 * etap);
+        const auto [dxi, deta] = clenshaw(series::alpha, sin2, cos2, (exp2 - 1 / exp2) / 2, (exp2 + 1 / exp2) / 2);
+        return {p.false_easting + p.radius * (etap + deta), p.false_northing + p.radius * (xip + dxi)};
+    }
+
+    //Тангенс широты по тангенсу конформной широты: шаги Ньютона conformal_inverse, развёрнутые при компиляции
+    template<size_t... I>
+    [[gnu::always_inline]] static double batch_conformal_inverse(double eccentricity, double taup, std::index_sequence<I...>){
+        constexpr auto e2m = 1 - static_cast<double>(Ellipsoid::eccentricity2);
+        auto tau = taup / e2m;
+        double root{}, sigma{}, taupa{};
+        ((void(I),
+          root = batch_sqrt(1 + tau * tau),
+          sigma = batch_sigma(eccentricity, tau, root),
+          taupa = tau * batch_sqrt(1 + sigma * sigma) - sigma * root,
+          tau += (taup - taupa) * (1 + e2m * tau * tau) / (e2m * root * batch_sqrt(1 + taupa * taupa))), ...);
+        return tau;
+    }
+
+    [[gnu::always_inline]] static std::pair<double, double> batch_inverse(const batch_parameter &p, double easting, double northing){
+        using series = kruger_series<double, Ellipsoid>;
+        const auto xi = (northing - p.false_northing) / p.radius;
+        const auto eta = (easting - p.false_easting) / p.radius;
+        const auto [sin2, cos2] = batch_sincos(2 * xi);
+        const auto exp2 = batch_exp(2 * eta);
+        const auto [dxi, deta] = clenshaw(series::beta, sin2, cos2, (exp2 - 1 / exp2) / 2, (exp2 + 1 / exp2) / 2);
+        const auto xip = xi - dxi;
+        const auto etap = eta - deta;
+        const auto [sin_xip, cos_xip] = batch_sincos(xip);
+        const auto exp1 = batch_exp(etap);
+        const auto sinh_etap = (exp1 - 1 / exp1) / 2;
+        const auto taup = sin_xip / batch_sqrt(sinh_etap * sinh_etap + cos_xip * cos_xip);
+        const auto lambda = batch_atan2(sinh_etap, cos_xip);
+        const auto tau = batch_conformal_inverse(p.eccentricity, taup, std::make_index_sequence<iterations>());
+        const auto longitude = p.central_meridian + lambda;
+        //atan(tau) через половинный угол: с постоянным x = 1 в batch_atan2 компилятор превращает min и max в ветвления
+        return {2 * batch_atan2(tau, 1 + batch_sqrt(1 + tau * tau)),
+                longitude - algorithm::pi_in_2<double> * batch_round(longitude / algorithm::pi_in_2<double>).first};
+    }
+
+    Type central_meridian_;
+    Type scale_;
+    Type false_easting_;
+    Type false_northing_;
+    Type eccentricity_;
+    Type radius_;   //!Масштаб * радиус спрямляющей сферы
+};
+
+//Координаты UTM: номер зоны, полушарие, easting и northing (м)
+template<std::floating_point Type>
+struct utm_coordinate{
+    int zone;
+    bool north;
+    Type easting;
+    Type northing;
+};
+
+//Номер зоны UTM с исключениями для Норвегии и Шпицбергена. Широта вне [-80, 84] градусов - ошибка
+template<std::floating_point Type>
+int utm_zone(Type latitude, Type longitude){
+    const auto lat = latitude / algorithm::pi_on_180<Type>;
+    const auto lon = normalize_longitude(longitude) / algorithm::pi_on_180<Type>;
+    if((lat < -80) || (lat > 84)){
+        throw std::logic_error("utm_zone: latitude out of range");
+    }
+    if((lat >= 56) && (lat < 64) && (lon >= 3) && (lon < 12)){
+        return 32;
+    }
+    if((lat >= 72) && (lon >= 0) && (lon < 42)){
+        return (lon < 9) ? 31 : (lon < 21) ? 33 : (lon < 33) ? 35 : 37;
+    }
+    return std::min(static_cast<int>(std::floor((lon + 180) / 6)) + 1, 60);
+}
+
+//Общая зона для набора точек: зона среднего направления долгот (устойчиво к переходу через антимеридиан).
+//Точки набора у краёв зоны проецируются в эту же зону, проекция остаётся точной в расширенной полосе
+template<c_point2d_geo PointGeo>
+int utm_zone(const std::vector<PointGeo> &points){
+    using Type = PointGeo::type_coordinate;
+    if(points.empty()){
+        throw std::logic_error("utm_zone: empty set");
+    }
+    Type x{}, y{}, latitude{};
+    for(const auto &point : points){
+        x += std::cos(static_cast<Type>(point.longitude()));
+        y += std::sin(static_cast<Type>(point.longitude()));
+        latitude += static_cast<Type>(point.latitude());
+    }
+    latitude /= static_cast<Type>(points.size());
+    return utm_zone(latitude, std::atan2(y, x));
+}
+
+template<std::floating_point Type>
+constexpr Type utm_central_meridian(int zone){
+    if((zone < 1) || (zone > 60)){
+        throw std::logic_error("utm_central_meridian: invalid zone");
+    }
+    return (6 * zone - 183) * algorithm::pi_on_180<Type>;
+}
+
+//Проекция зоны UTM (в южном полушарии ложный сдвиг на север 10000 км). Эллипсоид по умолчанию - WGS84, как в стандарте UTM
+template<std::floating_point Type,
+         c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>,
+         c_ellipsoid Ellipsoid = wgs84<Type>>
+transverse_mercator<Type, ClassFunc, Ellipsoid> utm(int zone, bool north = true){
+    return transverse_mercator<Type, ClassFunc, Ellipsoid>(utm_central_meridian<Type>(zone), 0.9996, 500'000.,
+                                                           north ? 0. : 10'000'000.);
+}
+
+//Координаты UTM точки. zone = 0 - зона выбирается по точке, иначе точка проецируется в заданную зону
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = wgs84<typename PointGeo::type_coordinate>>
+utm_coordinate<typename PointGeo::type_coordinate> to_utm(const PointGeo &point, int zone = 0){
+    using Type = PointGeo::type_coordinate;
+    const auto latitude = static_cast<Type>(point.latitude());
+    const auto longitude = static_cast<Type>(point.longitude());
+    if(zone == 0){
+        zone = utm_zone(latitude, longitude);
+    }
+    const auto north = latitude >= 0;
+    const auto [easting, northing] = utm<Type, ClassFunc, Ellipsoid>(zone, north).forward(latitude, longitude);
+    return {zone, north, easting, northing};
+}
+
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = wgs84<typename PointGeo::type_coordinate>>
+PointGeo from_utm(const utm_coordinate<typename PointGeo::type_coordinate> &coordinate){
+    using Type = PointGeo::type_coordinate;
+    const auto [latitude, longitude] = utm<Type, ClassFunc, Ellipsoid>(coordinate.zone, coordinate.north)
+                                           .inverse(coordinate.easting, coordinate.northing);
+    return PointGeo(latitude, longitude);
+}
+
+
+//Номер плитки пирамиды Web Mercator на уровне масштаба (x - на восток, y - на юг)
+struct tile_index{
+    std::uint32_t x;
+    std::uint32_t y;
+
+    friend constexpr bool operator==(const tile_index &, const tile_index &) = default;
+};
+
+//Точки, сгруппированные по плиткам: плитки по возрастанию (y, x), индексы точек плитки идут подряд
+//в исходном порядке, поэтому задание отрисовки обрабатывает каждую плитку непрерывным участком
+class tile_buckets{
+public:
+    tile_buckets() = default;
+    tile_buckets(unsigned zoom, std::vector<std::uint64_t> keys, std::vector<size_t> offsets, std::vector<size_t> order)
+        : zoom_(zoom), keys_(std::move(keys)), offsets_(std::move(offsets)), order_(std::move(order)){}
+
+    unsigned zoom() const{
+        return zoom_;
+    }
+    //Число непустых плиток
+    size_t size() const{
+        return keys_.size();
+    }
+    bool empty() const{
+        return keys_.empty();
+    }
+    tile_index tile(size_t i) const{
+        const auto mask = (std::uint64_t(1) << zoom_) - 1;
+        return {static_cast<std::uint32_t>(keys_[i] & mask), static_cast<std::uint32_t>(keys_[i] >> zoom_)};
+    }
+    //Индексы точек плитки i
+    std::span<const size_t> points(size_t i) const{
+        return std::span<const size_t>(order_).subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+    //Индексы всех точек в порядке плиток
+    const std::vector<size_t> &order() const{
+        return order_;
+    }
+
+private:
+    unsigned zoom_{};
+    std::vector<std::uint64_t> keys_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> order_;
+};
+
+//Проекция Web Mercator (сфера с радиусом большой полуоси, EPSG:3857) в пиксели пирамиды плиток уровня zoom.
+//Пиксельные координаты отсчитываются от северо-западного угла мира: x - на восток, y - на юг.
+//Широта ограничивается max_latitude, за которой мир перестаёт быть квадратным
+template<std::floating_point Type, c_function_angle<Type> ClassFunc = algorithm::function_angle<Type>>
+class web_mercator{
+public:
+    //!atan(sinh(pi)) = 85.05112878 градуса
+    static constexpr Type max_latitude = 1.4844222297453324;
+    static constexpr unsigned max_zoom = 30;
+
+    explicit web_mercator(unsigned zoom, unsigned tile_size = 256) : zoom_(zoom), tile_size_(tile_size){
+        if((zoom > max_zoom) || (tile_size == 0)){
+            throw std::logic_error("web_mercator: invalid zoom or tile size");
+        }
+        world_ = static_cast<Type>(tile_size) * static_cast<Type>(std::uint64_t(1) << zoom);
+    }
+
+    unsigned zoom() const{
+        return zoom_;
+    }
+    unsigned tile_size() const{
+        return tile_size_;
+    }
+    //Размер мира в пикселях
+    Type world_size() const{
+        return world_;
+    }
+    //Число плиток по каждой оси
+    std::uint32_t tiles() const{
+        return std::uint32_t(1) << zoom_;
+    }
+
+    //Пиксельные координаты {x, y}
+    std::pair<Type, Type> forward(Type latitude, Type longitude) const{
+        const auto sin_latitude = ClassFunc::sin(std::clamp(latitude, -max_latitude, max_latitude));
+        const auto x = (normalize_longitude(longitude) + algorithm::pi<Type>) / algorithm::pi_in_2<Type>;
+        const auto y = (algorithm::pi<Type> - std::atanh(sin_latitude)) / algorithm::pi_in_2<Type>;
+        return {x * world_, y * world_};
+    }
+
+    //Широта и долгота по пиксельным координатам
+    std::pair<Type, Type> inverse(Type x, Type y) const{
+        const auto latitude = ClassFunc::atan(std::sinh(algorithm::pi<Type> - algorithm::pi_in_2<Type> * y / world_));
+        return {latitude, algorithm::pi_in_2<Type> * x / world_ - algorithm::pi<Type>};
+    }
+
+    template<c_point2d_decard Point, c_point2d_geo PointGeo>
+    Point forward(const PointGeo &point) const{
+        const auto [x, y] = forward(static_cast<Type>(point.latitude()), static_cast<Type>(point.longitude()));
+        return Point(x, y);
+    }
+
+    template<c_point2d_geo PointGeo, c_point2d_decard Point>
+    PointGeo inverse(const Point &point) const{
+        const auto [latitude, longitude] = inverse(static_cast<Type>(point.x()), static_cast<Type>(point.y()));
+        return PointGeo(latitude, longitude);
+    }
+
+    //Пакетное прямое преобразование массивов широт и долгот в пиксельные координаты
+    void forward(std::span<const Type> latitude, std::span<const Type> longitude, std::span<Type> x, std::span<Type> y) const{
+        check_size(latitude.size(), longitude.size(), x.size(), y.size());
+        for(size_t i = 0; i < latitude.size(); ++i){
+            const auto [px, py] = forward(latitude[i], longitude[i]);
+            x[i] = px;
+            y[i] = py;
+        }
+    }
+
+    void inverse(std::span<const Type> x, std::span<const Type> y, std::span<Type> latitude, std::span<Type> longitude) const{
+        check_size(x.size(), y.size(), latitude.size(), longitude.size());
+        for(size_t i = 0; i < x.size(); ++i){
+            const auto [lat, lon] = inverse(x[i], y[i]);
+            latitude[i] = lat;
+            longitude[i] = lon;
+        }
+    }
+
+    //Плитка, содержащая пиксель (координаты за пределами мира прижимаются к краю)
+    tile_index tile(Type x, Type y) const{
+        return {tile_coordinate(x), tile_coordinate(y)};
+    }
+
+    template<c_point2d_geo PointGeo>
+    tile_index tile(const PointGeo &point) const{
+        const auto [x, y] = forward(static_cast<Type>(point.latitude()), static_cast<Type>(point.longitude()));
+        return tile(x, y);
+    }
+
+    //Географические границы плитки
+    geo_box<Type> bounds(const tile_index &tile) const{
+        const auto size = static_cast<Type>(tile_size_);
+        const auto [north, west] = inverse(tile.x * size, tile.y * size);
+        const auto [south, east] = inverse((tile.x + Type(1)) * size, (tile.y + Type(1)) * size);
+        return {south, north, west, east};
+    }
+
+    //Группировка пикселей по плиткам поразрядной сортировкой (LSD, по 8 бит) ключей y * 2^zoom + x.
+    //Сортировка устойчива, проходы по разрядам, одинаковым у всех ключей, пропускаются
+    tile_buckets bucket(std::span<const Type> x, std::span<const Type> y) const{
+        if(x.size() != y.size()){
+            throw std::logic_error("web_mercator: size mismatch");
+        }
+        const auto count = x.size();
+        std::vector<std::uint64_t> keys(count);
+        std::vector<size_t> order(count);
+        for(size_t i = 0; i < count; ++i){
+            keys[i] = (std::uint64_t(tile_coordinate(y[i])) << zoom_) | tile_coordinate(x[i]);
+            order[i] = i;
+        }
+        std::vector<std::uint64_t> keys_temp(count);
+        std::vector<size_t> order_temp(count);
+        for(unsigned shift = 0; shift < 2 * zoom_; shift += 8){
+            std::array<size_t, 257> offsets{};
+            for(const auto key : keys){
+                ++offsets[((key >> shift) & 0xff) + 1];
+            }
+            if(std::ranges::any_of(offsets, [count](size_t value){ return value == count; })){
+                continue;
+            }
+            for(size_t i = 1; i < offsets.size(); ++i){
+                offsets[i] += offsets[i - 1];
+            }
+            for(size_t i = 0; i < count; ++i){
+                const auto position = offsets[(keys[i] >> shift) & 0xff]++;
+                keys_temp[position] = keys[i];
+                order_temp[position] = order[i];
+            }
+            keys.swap(keys_temp);
+            order.swap(order_temp);
+        }
+        std::vector<std::uint64_t> unique;
+        std::vector<size_t> bounds;
+        for(size_t i = 0; i < count; ++i){
+            if(unique.empty() || (unique.back() != keys[i])){
+                unique.push_back(keys[i]);
+                bounds.push_back(i);
+            }
+        }
+        bounds.push_back(count);
+        return tile_buckets(zoom_, std::move(unique), std::move(bounds), std::move(order));
+    }
+
+    template<c_point2d_geo PointGeo>
+    tile_buckets bucket(const std::vector<PointGeo> &points) const{
+        std::vector<Type> x(points.size());
+        std::vector<Type> y(points.size());
+        for(size_t i = 0; i < points.size(); ++i){
+            std::tie(x[i], y[i]) = forward(static_cast<Type>(points[i].latitude()), static_cast<Type>(points[i].longitude()));
+        }
+        return bucket(std::span<const Type>(x), std::span<const Type>(y));
+    }
+
+private:
+    std::uint32_t tile_coordinate(Type pixel) const{
+        const auto value = std::floor(pixel / static_cast<Type>(tile_size_));
+        return static_cast<std::uint32_t>(std::clamp(value, Type(), static_cast<Type>(tiles() - 1)));
+    }
+
+    static void check_size(size_t size1, size_t size2, size_t size3, size_t size4){
+        if((size1 != size2) || (size3 < size1) || (size4 < size1)){
+            throw std::logic_error("web_mercator: size mismatch");
+        }
+    }
+
+    unsigned zoom_;
+    unsigned tile_size_;
+    Type world_;
+};
+
+}
+
+#endif // PROJECTION_ALGORITHM_H
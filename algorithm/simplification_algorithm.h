@@ -0,0 +1,300 @@
+#ifndef SIMPLIFICATION_ALGORITHM_H
+#define SIMPLIFICATION_ALGORITHM_H
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "point_algorithm.h"
+#include "../structs/point_cloud_impl.h"
+
+namespace agl::simplification_algo{
+
+namespace {
+
+//Квадрат расстояния от точки (px, py) до отрезка (ax, ay) - (bx, by)
+template<std::floating_point Type>
+constexpr Type distance2_to_section(Type px, Type py, Type ax, Type ay, Type bx, Type by){
+    const auto dx = bx - ax;
+    const auto dy = by - ay;
+    const auto length2 = dx * dx + dy * dy;
+    auto t = (length2 > 0) ? ((px - ax) * dx + (py - ay) * dy) / length2 : Type{};
+    t = std::clamp(t, Type{}, Type(1));
+    const auto ex = ax + t * dx - px;
+    const auto ey = ay + t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+//Удвоенная площадь треугольника
+template<std::floating_point Type>
+constexpr Type area2(Type ax, Type ay, Type bx, Type by, Type cx, Type cy){
+    return std::abs(algorithm::determine(bx - ax, by - ay, cx - ax, cy - ay));
+}
+
+//Дуглас-Пекер с явным стеком на диапазоне [first, last], отмечает сохраняемые внутренние вершины в keep
+template<std::floating_point Type, typename Get>
+void douglas_peucker_mark(Get &&get, size_t first, size_t last, Type tolerance, std::vector<char> &keep){
+    const auto tolerance2 = tolerance * tolerance;
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(first, last);
+    while(!stack.empty()){
+        const auto [begin, end] = stack.back();
+        stack.pop_back();
+        if(end <= begin + 1){
+            continue;
+        }
+        const auto [ax, ay] = get(begin);
+        const auto [bx, by] = get(end);
+        Type max_distance{-1};
+        size_t index = begin;
+        for(size_t i = begin + 1; i < end; ++i){
+            const auto [px, py] = get(i);
+            const auto d = distance2_to_section(px, py, ax, ay, bx, by);
+            if(d > max_distance){
+                max_distance = d;
+                index = i;
+            }
+        }
+        if(max_distance > tolerance2){
+            keep[index] = 1;
+            stack.emplace_back(begin, index);
+            stack.emplace_back(index, end);
+        }
+    }
+}
+
+//Разбивает диапазон на куски и обрабатывает их параллельно, границы кусков сохраняются всегда
+template<std::floating_point Type, typename Get>
+std::vector<char> douglas_peucker_keep(Get &&get, size_t size, Type tolerance, size_t threads, size_t min_chunk){
+    std::vector<char> keep(size, 0);
+    if(size < 3){
+        std::ranges::fill(keep, 1);
+        return keep;
+    }
+    const auto count = std::clamp<size_t>((size - 1) / std::max<size_t>(min_chunk, 2), 1, std::max<size_t>(threads, 1));
+    keep.front() = 1;
+    keep.back() = 1;
+    if(count == 1){
+        douglas_peucker_mark(get, 0, size - 1, tolerance, keep);
+        return keep;
+    }
+    const auto step = (size - 1) / count;
+    for(size_t i = 1; i < count; ++i){
+        keep[i * step] = 1;
+    }
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(count);
+    for(size_t i = 0; i < count; ++i){
+        const auto first = i * step;
+        const auto last = (i + 1 == count) ? size - 1 : (i + 1) * step;
+        //Каждый кусок пишет только в свои внутренние элементы keep
+        tasks.push_back(std::async(std::launch::async, [&get, first, last, tolerance, &keep](){
+            douglas_peucker_mark(get, first, last, tolerance, keep);
+        }));
+    }
+    for(auto &task : tasks){
+        task.get();
+    }
+    return keep;
+}
+
+//Visvalingam–Whyatt: удаляет вершины с наименьшей эффективной площадью, пока она меньше min_area
+template<std::floating_point Type, typename Get>
+std::vector<char> visvalingam_keep(Get &&get, size_t size, Type min_area){
+    std::vector<char> keep(size, 1);
+    if(size < 3){
+        return keep;
+    }
+    std::vector<size_t> prev(size);
+    std::vector<size_t> next(size);
+    std::vector<Type> area(size, std::numeric_limits<Type>::infinity());
+    auto calc = [&get, &prev, &next](size_t i){
+        const auto [ax, ay] = get(prev[i]);
+        const auto [bx, by] = get(i);
+        const auto [cx, cy] = get(next[i]);
+        return area2(ax, ay, bx, by, cx, cy) / 2;
+    };
+
+    using item = std::pair<Type, size_t>;
+    std::vector<item> storage;
+    storage.reserve(size);
+    for(size_t i = 0; i < size; ++i){
+        prev[i] = (i > 0) ? i - 1 : 0;
+        next[i] = i + 1;
+    }
+    for(size_t i = 1; i + 1 < size; ++i){
+        area[i] = calc(i);
+        storage.emplace_back(area[i], i);
+    }
+    std::priority_queue<item, std::vector<item>, std::greater<item>> heap(std::greater<item>{}, std::move(storage));
+
+    Type max_area{};
+    while(!heap.empty()){
+        const auto [value, index] = heap.top();
+        heap.pop();
+        //Устаревшая запись кучи: площадь вершины была пересчитана или вершина удалена
+        if(!keep[index] || (value != area[index])){
+            continue;
+        }
+        //Эффективная площадь не может быть меньше площади ранее удалённых вершин
+        max_area = std::max(max_area, value);
+        if(!(max_area < min_area)){
+            break;
+        }
+        keep[index] = 0;
+        const auto p = prev[index];
+        const auto n = next[index];
+        next[p] = n;
+        prev[n] = p;
+        if(p > 0){
+            area[p] = calc(p);
+            heap.emplace(area[p], p);
+        }
+        if(n + 1 < size){
+            area[n] = calc(n);
+            heap.emplace(area[n], n);
+        }
+    }
+    return keep;
+}
+
+template<c_point2d_decard Point>
+std::vector<Point> select(const std::vector<Point> &points, const std::vector<char> &keep){
+    std::vector<Point> temp;
+    temp.reserve(std::ranges::count(keep, 1));
+    for(size_t i = 0; i < points.size(); ++i){
+        if(keep[i]){
+            temp.push_back(points[i]);
+        }
+    }
+    return temp;
+}
+
+template<std::floating_point Type>
+point_cloud2d_impl<Type> select(const point_cloud2d_impl<Type> &points, const std::vector<char> &keep){
+    point_cloud2d_impl<Type> temp;
+    temp.reserve(std::ranges::count(keep, 1));
+    for(size_t i = 0; i < points.size(); ++i){
+        if(keep[i]){
+            temp.push_back(points.x(i), points.y(i));
+        }
+    }
+    return temp;
+}
+
+template<c_point2d_decard Point>
+auto getter(const std::vector<Point> &points){
+    return [&points](size_t i){
+        return std::pair{points[i].x(), points[i].y()};
+    };
+}
+
+template<std::floating_point Type>
+auto getter(const point_cloud2d_impl<Type> &points){
+    return [x = points.xs().data(), y = points.ys().data()](size_t i){
+        return std::pair{x[i], y[i]};
+    };
+}
+
+}
+
+//Упрощение ломаной алгоритмом Дугласа-Пекера (отклонение от результата не больше tolerance)
+template<c_point2d_decard Point>
+std::vector<Point> douglas_peucker(const std::vector<Point> &points, typename Point::type_coordinate tolerance){
+    return select(points, douglas_peucker_keep(getter(points), points.size(), tolerance, 1, points.size()));
+}
+
+template<std::floating_point Type>
+point_cloud2d_impl<Type> douglas_peucker(const point_cloud2d_impl<Type> &points, Type tolerance){
+    return select(points, douglas_peucker_keep(getter(points), points.size(), tolerance, 1, points.size()));
+}
+
+//Параллельный вариант: ломаная делится на куски не короче min_chunk точек, каждый упрощается в своём потоке.
+//Границы кусков сохраняются всегда, поэтому набор вершин может немного отличаться от последовательного варианта
+template<c_point2d_decard Point>
+std::vector<Point> douglas_peucker_parallel(const std::vector<Point> &points, typename Point::type_coordinate tolerance,
+                                            size_t threads = std::thread::hardware_concurrency(), size_t min_chunk = 16384){
+    return select(points, douglas_peucker_keep(getter(points), points.size(), tolerance, threads, min_chunk));
+}
+
+template<std::floating_point Type>
+point_cloud2d_impl<Type> douglas_peucker_parallel(const point_cloud2d_impl<Type> &points, Type tolerance,
+                                                  size_t threads = std::thread::hardware_concurrency(), size_t min_chunk = 16384){
+    return select(points, douglas_peucker_keep(getter(points), points.size(), tolerance, threads, min_chunk));
+}
+
+//Упрощение ломаной алгоритмом Висвалингама-Уайетта (удаляются вершины с эффективной площадью меньше min_area)
+template<c_point2d_decard Point>
+std::vector<Point> visvalingam(const std::vector<Point> &points, typename Point::type_coordinate min_area){
+    return select(points, visvalingam_keep(getter(points), points.size(), min_area));
+}
+
+template<std::floating_point Type>
+point_cloud2d_impl<Type> visvalingam(const point_cloud2d_impl<Type> &points, Type min_area){
+    return select(points, visvalingam_keep(getter(points), points.size(), min_area));
+}
+
+//Потоковое упрощение трека (алгоритм "открытого окна"): точки подаются по одной,
+//вершина выдаётся, как только окно от последней выданной вершины перестаёт укладываться в tolerance
+template<c_point2d_decard Point>
+class stream_simplifier{
+public:
+    using Type = Point::type_coordinate;
+
+    stream_simplifier(Type tolerance, size_t max_window = 256)
+        : tolerance2_(tolerance * tolerance), max_window_(std::max<size_t>(max_window, 2)){
+        window_.reserve(max_window_);
+    }
+
+    //Добавляет точку, возвращает новую вершину упрощённого трека, если она определилась
+    std::optional<Point> push(const Point &point){
+        if(!anchor_.has_value()){
+            anchor_ = point;
+            return anchor_;
+        }
+        if(!window_.empty() && ((window_.size() >= max_window_) || !fits(point))){
+            anchor_ = window_.back();
+            window_.clear();
+            window_.push_back(point);
+            return anchor_;
+        }
+        window_.push_back(point);
+        return std::nullopt;
+    }
+
+    //Завершает трек, возвращает последнюю точку, если она ещё не выдана
+    std::optional<Point> flush(){
+        if(window_.empty()){
+            return std::nullopt;
+        }
+        anchor_ = window_.back();
+        window_.clear();
+        return anchor_;
+    }
+
+    void reset(){
+        anchor_.reset();
+        window_.clear();
+    }
+
+private:
+    bool fits(const Point &point) const{
+        const auto &anchor = anchor_.value();
+        return std::ranges::all_of(window_, [&anchor, &point, this](const Point &item){
+            return distance2_to_section(item.x(), item.y(), anchor.x(), anchor.y(), point.x(), point.y()) <= tolerance2_;
+        });
+    }
+
+    Type tolerance2_;
+    size_t max_window_;
+    std::optional<Point> anchor_;
+    std::vector<Point> window_;
+};
+
+}
+
+#endif // SIMPLIFICATION_ALGORITHM_H
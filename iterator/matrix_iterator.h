@@ -1,63 +1,87 @@
 #ifndef MATRIX_ITERATOR_H
 #define MATRIX_ITERATOR_H
 
+#include <compare>
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
+
+//matrix_iterator и matrix_column_iterator (обход внутри строки) идут по соседним элементам и моделируют
+//std::contiguous_iterator, matrix_row_iterator (обход столбца с шагом Column) - std::random_access_iterator
 
 template<typename Type, size_t Row, size_t Column>
 struct matrix_iterator{
-    using iterator_category = std::contiguous_iterator_tag;
-    using value_type = Type;
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<Type>;
+    using element_type = Type;
     using difference_type = std::ptrdiff_t;
     using pointer = Type*;
     using reference = Type&;
 
     matrix_iterator() = default;
-    matrix_iterator(pointer p) : p_(p){}
-    matrix_iterator(const matrix_iterator &it): p_(it.p_){}
+    constexpr matrix_iterator(pointer p) : p_(p){}
+    template<typename Other> requires (!std::is_same_v<Other, Type>) && std::is_same_v<const Other, Type>
+    constexpr matrix_iterator(const matrix_iterator<Other, Row, Column> &it) : p_(it.get()){}
 
-    pointer get() const{
+    constexpr pointer get() const{
         return p_;
     }
 
-    bool operator!=(const matrix_iterator& other) const{
-        return p_ != other.p_;
-    }
-    bool operator==(const matrix_iterator& other) const{
-        return p_ == other.p_;
-    }
-    reference operator*(){
-        return *p_;
-    }
-    reference operator*() const{
+    constexpr reference operator*() const{
         return *p_;
     }
-    pointer operator->(){
+    constexpr pointer operator->() const{
         return p_;
     }
+    constexpr reference operator[](difference_type n) const{
+        return p_[n];
+    }
 
-    matrix_iterator& operator++(){
+    constexpr matrix_iterator& operator++(){
         ++p_;
         return *this;
     }
-    matrix_iterator operator++(int){
+    constexpr matrix_iterator operator++(int){
         matrix_iterator tmp = *this;
         ++(*this);
         return tmp;
     }
-    matrix_iterator& operator--(){
+    constexpr matrix_iterator& operator--(){
         --p_;
         return *this;
     }
+    constexpr matrix_iterator operator--(int){
+        matrix_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
 
-    matrix_iterator &operator+=(int value){
-        p_ += value;
+    constexpr matrix_iterator &operator+=(difference_type n){
+        p_ += n;
+        return *this;
+    }
+    constexpr matrix_iterator &operator-=(difference_type n){
+        p_ -= n;
         return *this;
     }
 
-    friend int operator-(const matrix_iterator& temp1, const matrix_iterator& temp2){
+    friend constexpr matrix_iterator operator+(matrix_iterator it, difference_type n){
+        return it += n;
+    }
+    friend constexpr matrix_iterator operator+(difference_type n, matrix_iterator it){
+        return it += n;
+    }
+    friend constexpr matrix_iterator operator-(matrix_iterator it, difference_type n){
+        return it -= n;
+    }
+    friend constexpr difference_type operator-(const matrix_iterator& temp1, const matrix_iterator& temp2){
         return temp1.p_ - temp2.p_;
     }
 
+    friend constexpr bool operator==(const matrix_iterator& temp1, const matrix_iterator& temp2) = default;
+    friend constexpr auto operator<=>(const matrix_iterator& temp1, const matrix_iterator& temp2) = default;
+
 private:
     pointer p_{};
 };
@@ -66,70 +90,75 @@ private:
 
 template<typename Type, size_t Row, size_t Column>
 struct matrix_row_iterator{
+    using iterator_concept = std::random_access_iterator_tag;
     using iterator_category = std::random_access_iterator_tag;
-    using value_type = Type;
+    using value_type = std::remove_cv_t<Type>;
     using difference_type = std::ptrdiff_t;
     using pointer = Type*;
     using reference = Type&;
 
     matrix_row_iterator() = default;
-    matrix_row_iterator(pointer p) : p_(p){}
-    matrix_row_iterator(const matrix_row_iterator &it): p_(it.p_){}
+    constexpr matrix_row_iterator(pointer p) : p_(p){}
+    template<typename Other> requires (!std::is_same_v<Other, Type>) && std::is_same_v<const Other, Type>
+    constexpr matrix_row_iterator(const matrix_row_iterator<Other, Row, Column> &it) : p_(it.get()){}
 
-    pointer get() const{
+    constexpr pointer get() const{
         return p_;
     }
 
-    bool operator!=(const matrix_row_iterator& other) const{
-        return p_ != other.p_;
-    }
-    bool operator==(const matrix_row_iterator& other) const{
-        return p_ == other.p_;
-    }
-    auto operator<=>(const matrix_row_iterator& other) const{
-        return p_ <=> other.p_;
-    }
-    reference operator*(){
-        return *p_;
-    }
-    reference operator*() const{
+    constexpr reference operator*() const{
         return *p_;
     }
-    pointer operator->(){
+    constexpr pointer operator->() const{
         return p_;
     }
+    constexpr reference operator[](difference_type n) const{
+        return p_[n * difference_type(Column)];
+    }
 
-    matrix_row_iterator& operator++(){
+    constexpr matrix_row_iterator& operator++(){
         p_ += Column;
         return *this;
     }
-    matrix_row_iterator operator++(int){
+    constexpr matrix_row_iterator operator++(int){
         matrix_row_iterator tmp = *this;
         ++(*this);
         return tmp;
     }
-    matrix_row_iterator& operator--(){
+    constexpr matrix_row_iterator& operator--(){
         p_ -= Column;
         return *this;
     }
-    matrix_row_iterator operator--(int){
+    constexpr matrix_row_iterator operator--(int){
         matrix_row_iterator tmp = *this;
         --(*this);
         return tmp;
     }
 
-    matrix_row_iterator &operator+=(int value){
-        p_ += Column * value;
+    constexpr matrix_row_iterator &operator+=(difference_type n){
+        p_ += n * difference_type(Column);
         return *this;
     }
-    matrix_row_iterator &operator-=(int value){
-        p_ += Column * value;
+    constexpr matrix_row_iterator &operator-=(difference_type n){
+        p_ -= n * difference_type(Column);
         return *this;
     }
 
-    friend int operator-(const matrix_row_iterator& temp1, const matrix_row_iterator& temp2){
-        return (temp1.p_ - temp2.p_) / Column;
+    friend constexpr matrix_row_iterator operator+(matrix_row_iterator it, difference_type n){
+        return it += n;
+    }
+    friend constexpr matrix_row_iterator operator+(difference_type n, matrix_row_iterator it){
+        return it += n;
     }
+    friend constexpr matrix_row_iterator operator-(matrix_row_iterator it, difference_type n){
+        return it -= n;
+    }
+    friend constexpr difference_type operator-(const matrix_row_iterator& temp1, const matrix_row_iterator& temp2){
+        return (temp1.p_ - temp2.p_) / difference_type(Column);
+    }
+
+    friend constexpr bool operator==(const matrix_row_iterator& temp1, const matrix_row_iterator& temp2) = default;
+    friend constexpr auto operator<=>(const matrix_row_iterator& temp1, const matrix_row_iterator& temp2) = default;
 
 private:
     pointer p_{};
@@ -139,71 +168,77 @@ private:
 
 template<typename ValueType, size_t Row, size_t Column>
 struct matrix_column_iterator{
-    using iterator_category = std::contiguous_iterator_tag;
-    using value_type = ValueType;
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<ValueType>;
+    using element_type = ValueType;
     using difference_type = std::ptrdiff_t;
     using pointer = ValueType*;
     using reference = ValueType&;
 
     matrix_column_iterator() = default;
-    matrix_column_iterator(pointer p) : p_(p){}
-    matrix_column_iterator(const matrix_column_iterator &it): p_(it.p_){}
+    constexpr matrix_column_iterator(pointer p) : p_(p){}
+    template<typename Other> requires (!std::is_same_v<Other, ValueType>) && std::is_same_v<const Other, ValueType>
+    constexpr matrix_column_iterator(const matrix_column_iterator<Other, Row, Column> &it) : p_(it.get()){}
 
-    pointer get() const{
+    constexpr pointer get() const{
         return p_;
     }
 
-    bool operator!=(const matrix_column_iterator& other) const{
-        return p_ != other.p_;
-    }
-    bool operator==(const matrix_column_iterator& other) const{
-        return p_ == other.p_;
-    }
-    auto operator<=>(const matrix_column_iterator& other) const{
-        return p_ <=> other.p_;
-    }
-    reference operator*(){
+    constexpr reference operator*() const{
         return *p_;
     }
-    reference operator*() const{
-        return *p_;
-    }
-    pointer operator->(){
+    constexpr pointer operator->() const{
         return p_;
     }
+    constexpr reference operator[](difference_type n) const{
+        return p_[n];
+    }
 
-    matrix_column_iterator& operator++(){
+    constexpr matrix_column_iterator& operator++(){
         ++p_;
         return *this;
     }
-    matrix_column_iterator operator++(int){
+    constexpr matrix_column_iterator operator++(int){
         matrix_column_iterator tmp = *this;
         ++(*this);
         return tmp;
     }
-    matrix_column_iterator& operator--(){
+    constexpr matrix_column_iterator& operator--(){
         --p_;
         return *this;
     }
-    matrix_column_iterator operator--(int){
+    constexpr matrix_column_iterator operator--(int){
         matrix_column_iterator tmp = *this;
         --(*this);
         return tmp;
     }
 
-    matrix_column_iterator &operator+=(int value){
-        p_ += value;
+    constexpr matrix_column_iterator &operator+=(difference_type n){
+        p_ += n;
         return *this;
     }
-    matrix_column_iterator &operator-=(int value){
-        p_ += value;
+    constexpr matrix_column_iterator &operator-=(difference_type n){
+        p_ -= n;
         return *this;
     }
 
-    friend int operator-(const matrix_column_iterator& temp1, const matrix_column_iterator& temp2){
+    friend constexpr matrix_column_iterator operator+(matrix_column_iterator it, difference_type n){
+        return it += n;
+    }
+    friend constexpr matrix_column_iterator operator+(difference_type n, matrix_column_iterator it){
+        return it += n;
+    }
+    friend constexpr matrix_column_iterator operator-(matrix_column_iterator it, difference_type n){
+        return it -= n;
+    }
+    friend constexpr difference_type operator-(const matrix_column_iterator& temp1, const matrix_column_iterator& temp2){
         return temp1.p_ - temp2.p_;
     }
 
+    friend constexpr bool operator==(const matrix_column_iterator& temp1, const matrix_column_iterator& temp2) = default;
+    friend constexpr auto operator<=>(const matrix_column_iterator& temp1, const matrix_column_iterator& temp2) = default;
+
 private:
     pointer p_{};
 };
@@ -211,32 +246,32 @@ private:
 
 
 template<typename Type, size_t Row, size_t Column>
-auto convert_interator(matrix_row_iterator<Type,Row,Column> iterator) -> matrix_iterator<Type,Row,Column>{
+constexpr auto convert_interator(matrix_row_iterator<Type,Row,Column> iterator) -> matrix_iterator<Type,Row,Column>{
     return matrix_iterator<Type,Row,Column>(iterator.get());
 }
 
 template<typename Type, size_t Row, size_t Column>
-auto convert_interator(matrix_column_iterator<Type,Row,Column> iterator) -> matrix_iterator<Type,Row,Column>{
+constexpr auto convert_interator(matrix_column_iterator<Type,Row,Column> iterator) -> matrix_iterator<Type,Row,Column>{
     return matrix_iterator<Type,Row,Column>(iterator.get());
 }
 
 template<typename Type, size_t Row, size_t Column>
-auto convert_row_interator(matrix_iterator<Type,Row,Column> iterator) -> matrix_row_iterator<Type,Row,Column>{
+constexpr auto convert_row_interator(matrix_iterator<Type,Row,Column> iterator) -> matrix_row_iterator<Type,Row,Column>{
     return matrix_row_iterator<Type,Row,Column>(iterator.get());
 }
 
 template<typename Type, size_t Row, size_t Column>
-auto convert_row_interator(matrix_column_iterator<Type,Row,Column> iterator) -> matrix_row_iterator<Type,Row,Column>{
+constexpr auto convert_row_interator(matrix_column_iterator<Type,Row,Column> iterator) -> matrix_row_iterator<Type,Row,Column>{
     return matrix_row_iterator<Type,Row,Column>(iterator.get());
 }
 
 template<typename Type, size_t Row, size_t Column>
-auto convert_column_interator(matrix_iterator<Type,Row,Column> iterator) -> matrix_column_iterator<Type,Row,Column>{
+constexpr auto convert_column_interator(matrix_iterator<Type,Row,Column> iterator) -> matrix_column_iterator<Type,Row,Column>{
     return matrix_column_iterator<Type,Row,Column>(iterator.get());
 }
 
 template<typename Type, size_t Row, size_t Column>
-auto convert_column_interator(matrix_row_iterator<Type,Row,Column> iterator) -> matrix_column_iterator<Type,Row,Column>{
+constexpr auto convert_column_interator(matrix_row_iterator<Type,Row,Column> iterator) -> matrix_column_iterator<Type,Row,Column>{
     return matrix_column_iterator<Type,Row,Column>(iterator.get());
 }
 
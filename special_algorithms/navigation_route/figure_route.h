@@ -54,6 +54,21 @@ struct figure_route : figure_route_impl<agl::LineSection, arc_stage>{
     }
 };
 
+//Функция собирает ломаную с накопленной длиной из последовательности этапов маршрута
+inline agl::Polyline route_polyline(const std::vector<figure_route> &figures){
+    agl::Polyline polyline;
+    for(const auto &item : figures){
+        std::visit(overloaded{[&polyline](const agl::LineSection &object) {
+                                  polyline.append(object);
+                              },
+                              [&polyline](const arc_stage &object) {
+                                  polyline.append(object.arc, object.direct);
+                              }
+                   }, item.figure);
+    }
+    return polyline;
+}
+
 }
 
 
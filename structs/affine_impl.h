@@ -0,0 +1,392 @@
+#ifndef AFFINE_IMPL_H
+#define AFFINE_IMPL_H
+
+#include <array>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "matrix.h"
+#include "point_cloud_impl.h"
+#include "../system/system_concept.h"
+
+namespace agl {
+
+//Составные части аффинного преобразования плоскости: T * R(angle) * [[scale_x, shear], [0, scale_y]]
+template<std::floating_point Type>
+struct affine2d_parts{
+    Type dx;
+    Type dy;
+    Type angle;     //!Поворот по часовой стрелке (как point_algo::rotate)
+    Type scale_x;
+    Type scale_y;   //!Отрицателен для преобразования с отражением
+    Type shear;
+};
+
+//Составные части аффинного преобразования пространства: T * R * U, U - верхнетреугольная (масштаб и сдвиг)
+template<std::floating_point Type>
+struct affine3d_parts{
+    std::array<Type, 3> translation;
+    matrix<Type, 3, 3> rotation;
+    std::array<Type, 3> scale;
+    std::array<Type, 3> shear;      //!Элементы U(0,1), U(0,2), U(1,2)
+};
+
+//Аффинное преобразование размерности Dim (2 или 3) в однородных координатах на agl::matrix.
+//Цепочка преобразований сворачивается произведением в одну матрицу, применение к данным
+//выполняется один раз с коэффициентами, вынесенными из цикла
+template<std::floating_point Type, size_t Dim> requires (Dim == 2) || (Dim == 3)
+class affine_impl{
+public:
+    using type = Type;
+    using matrix_type = matrix<Type, Dim + 1, Dim + 1>;
+    static constexpr size_t dimension = Dim;
+
+    constexpr affine_impl() : matrix_(matrix_algo::identity_matrix<matrix, Type, Dim + 1>()){}
+    //Матрица должна иметь последнюю строку (0, ..., 0, 1)
+    constexpr explicit affine_impl(const matrix_type &m) : matrix_(m){
+        for(size_t i = 0; i < Dim; ++i){
+            if(!algorithm::compare(m.value(Dim, i), Type{})){
+                throw std::logic_error("affine_impl: matrix is not affine");
+            }
+        }
+        if(!algorithm::compare(m.value(Dim, Dim), Type(1))){
+            throw std::logic_error("affine_impl: matrix is not affine");
+        }
+    }
+
+    static constexpr affine_impl translation(Type dx, Type dy) requires (Dim == 2){
+        return affine_impl(matrix_type{1, 0, dx,
+                                       0, 1, dy,
+                                       0, 0, 1});
+    }
+    static constexpr affine_impl translation(Type dx, Type dy, Type dh) requires (Dim == 3){
+        return affine_impl(matrix_type{1, 0, 0, dx,
+                                       0, 1, 0, dy,
+                                       0, 0, 1, dh,
+                                       0, 0, 0, 1});
+    }
+
+    static constexpr affine_impl scale(Type sx, Type sy) requires (Dim == 2){
+        return affine_impl(matrix_type{sx, 0, 0,
+                                       0, sy, 0,
+                                       0, 0, 1});
+    }
+    static constexpr affine_impl scale(Type sx, Type sy, Type sh) requires (Dim == 3){
+        return affine_impl(matrix_type{sx, 0, 0, 0,
+                                       0, sy, 0, 0,
+                                       0, 0, sh, 0,
+                                       0, 0, 0, 1});
+    }
+
+    //Поворот плоскости по часовой стрелке (углы отсчитываются от оси y), как в point_algo::rotate
+    static constexpr affine_impl rotation(Type angle) requires (Dim == 2){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle);
+        return affine_impl(matrix_type{c, s, 0,
+                                       -s, c, 0,
+                                       0, 0, 1});
+    }
+    //Поворот вокруг точки center
+    template<c_point2d_decard Point>
+    static constexpr affine_impl rotation(Type angle, const Point &center) requires (Dim == 2){
+        return translation(center.x(), center.y()) * rotation(angle) * translation(-center.x(), -center.y());
+    }
+    template<c_angle Angle>
+    static constexpr affine_impl rotation(const Angle &angle) requires (Dim == 2){
+        return rotation(static_cast<Type>(angle.radian()));
+    }
+
+    //Поворот пространства вокруг оси h по часовой стрелке (курс)
+    static constexpr affine_impl rotation_h(Type angle) requires (Dim == 3){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle);
+        return affine_impl(matrix_type{c, s, 0, 0,
+                                       -s, c, 0, 0,
+                                       0, 0, 1, 0,
+                                       0, 0, 0, 1});
+    }
+    //Поворот вокруг оси x: положительный угол поднимает ось y (тангаж)
+    static constexpr affine_impl rotation_x(Type angle) requires (Dim == 3){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle);
+        return affine_impl(matrix_type{1, 0, 0, 0,
+                                       0, c, -s, 0,
+                                       0, s, c, 0,
+                                       0, 0, 0, 1});
+    }
+    //Поворот вокруг оси y: положительный угол поднимает ось x (крен)
+    static constexpr affine_impl rotation_y(Type angle) requires (Dim == 3){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle);
+        return affine_impl(matrix_type{c, 0, -s, 0,
+                                       0, 1, 0, 0,
+                                       s, 0, c, 0,
+                                       0, 0, 0, 1});
+    }
+
+    constexpr const matrix_type &get() const{
+        return matrix_;
+    }
+
+    //Композиция: сначала transform2, затем transform1
+    constexpr friend affine_impl operator*(const affine_impl &transform1, const affine_impl &transform2){
+        affine_impl temp;
+        temp.matrix_ = transform1.matrix_ * transform2.matrix_;
+        return temp;
+    }
+    //Композиция в порядке применения: сначала this, затем next
+    constexpr affine_impl then(const affine_impl &next) const{
+        return next * *this;
+    }
+
+    constexpr std::optional<affine_impl> inverse() const{
+        const auto temp = matrix_algo::inverse_matrix(matrix_);
+        if(!temp){
+            return std::nullopt;
+        }
+        return affine_impl(fix_last_row(temp.value()));
+    }
+
+    //Определитель линейной части
+    constexpr Type determinant() const{
+        if constexpr(Dim == 2){
+            return matrix_algo::determinant(std::array{matrix_.value(0, 0), matrix_.value(0, 1),
+                                                       matrix_.value(1, 0), matrix_.value(1, 1)});
+        }
+        else{
+            return matrix_algo::determinant(linear());
+        }
+    }
+
+    //Преобразование подобия (поворот, равномерный масштаб, перенос, возможно отражение): окружность переходит в окружность
+    constexpr bool is_similarity() const{
+        const auto l = linear();
+        const auto norm = std::abs(determinant());
+        if(algorithm::compare(norm, Type{})){
+            return false;
+        }
+        const auto k = std::pow(norm, Type(2) / Dim);
+        for(size_t i = 0; i < Dim; ++i){
+            for(size_t j = i; j < Dim; ++j){
+                Type dot{};
+                for(size_t r = 0; r < Dim; ++r){
+                    dot += l[r * Dim + i] * l[r * Dim + j];
+                }
+                if(!algorithm::compare(dot / k, (i == j) ? Type(1) : Type{})){
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    //Разложение на перенос, поворот, масштаб и сдвиг (QR-разложение линейной части по Граму-Шмидту)
+    affine2d_parts<Type> decompose() const requires (Dim == 2){
+        const auto a = matrix_.value(0, 0);
+        const auto b = matrix_.value(0, 1);
+        const auto c = matrix_.value(1, 0);
+        const auto d = matrix_.value(1, 1);
+        const auto scale_x = std::hypot(a, c);
+        if(algorithm::compare(scale_x, Type{})){
+            throw std::logic_error("affine_impl: degenerate transform");
+        }
+        //Поворот переводит ось x в (cos, -sin)
+        const auto cos_angle = a / scale_x;
+        const auto sin_angle = -c / scale_x;
+        return {matrix_.value(0, 2), matrix_.value(1, 2), std::atan2(sin_angle, cos_angle), scale_x,
+                sin_angle * b + cos_angle * d, cos_angle * b - sin_angle * d};
+    }
+
+    affine3d_parts<Type> decompose() const requires (Dim == 3){
+        const auto l = linear();
+        affine3d_parts<Type> temp{{matrix_.value(0, 3), matrix_.value(1, 3), matrix_.value(2, 3)}, {}, {}, {}};
+        std::array<Type, 9> u{};
+        std::array<std::array<Type, 3>, 3> q{};
+        for(size_t j = 0; j < 3; ++j){
+            std::array<Type, 3> v{l[j], l[3 + j], l[6 + j]};
+            for(size_t i = 0; i < j; ++i){
+                u[i * 3 + j] = q[i][0] * v[0] + q[i][1] * v[1] + q[i][2] * v[2];
+                for(size_t r = 0; r < 3; ++r){
+                    v[r] -= u[i * 3 + j] * q[i][r];
+                }
+            }
+            u[j * 3 + j] = matrix_algo::module(v);
+            if(algorithm::compare(u[j * 3 + j], Type{})){
+                throw std::logic_error("affine_impl: degenerate transform");
+            }
+            for(size_t r = 0; r < 3; ++r){
+                q[j][r] = v[r] / u[j * 3 + j];
+            }
+        }
+        //Отражение относится к масштабу по последней оси, чтобы поворот оставался собственным
+        if(matrix_algo::determinant(std::array{q[0][0], q[1][0], q[2][0], q[0][1], q[1][1], q[2][1], q[0][2], q[1][2], q[2][2]}) < 0){
+            for(size_t r = 0; r < 3; ++r){
+                q[2][r] = -q[2][r];
+            }
+            u[8] = -u[8];
+        }
+        for(size_t r = 0; r < 3; ++r){
+            for(size_t j = 0; j < 3; ++j){
+                temp.rotation.value(r, j) = q[j][r];
+            }
+        }
+        temp.scale = {u[0], u[4], u[8]};
+        temp.shear = {u[1], u[2], u[5]};
+        return temp;
+    }
+
+    template<c_point2d_decard Point> requires (Dim == 2)
+    constexpr Point apply(const Point &point) const{
+        const auto k = coefficients();
+        return Point(k[0] * point.x() + k[1] * point.y() + k[2], k[3] * point.x() + k[4] * point.y() + k[5]);
+    }
+
+    template<c_point3d_decard Point> requires (Dim == 3)
+    constexpr Point apply(const Point &point) const{
+        const auto k = coefficients();
+        return Point(k[0] * point.x() + k[1] * point.y() + k[2] * point.h() + k[3],
+                     k[4] * point.x() + k[5] * point.y() + k[6] * point.h() + k[7],
+                     k[8] * point.x() + k[9] * point.y() + k[10] * point.h() + k[11]);
+    }
+
+    //Пакетное применение на месте
+    template<typename Point> requires ((Dim == 2) && c_point2d_decard<Point>) || ((Dim == 3) && c_point3d_decard<Point>)
+    void apply(std::span<Point> points) const{
+        const auto k = coefficients();
+        for(auto &point : points){
+            if constexpr(Dim == 2){
+                point = Point(k[0] * point.x() + k[1] * point.y() + k[2], k[3] * point.x() + k[4] * point.y() + k[5]);
+            }
+            else{
+                point = Point(k[0] * point.x() + k[1] * point.y() + k[2] * point.h() + k[3],
+                              k[4] * point.x() + k[5] * point.y() + k[6] * point.h() + k[7],
+                              k[8] * point.x() + k[9] * point.y() + k[10] * point.h() + k[11]);
+            }
+        }
+    }
+
+    template<typename Point> requires ((Dim == 2) && c_point2d_decard<Point>) || ((Dim == 3) && c_point3d_decard<Point>)
+    std::vector<Point> apply(const std::vector<Point> &points) const{
+        auto temp = points;
+        apply(std::span<Point>(temp));
+        return temp;
+    }
+
+    //Раздельные массивы координат (облако точек): цикл без ветвлений векторизуется
+    void apply(std::span<Type> xs, std::span<Type> ys) const requires (Dim == 2){
+        if(xs.size() != ys.size()){
+            throw std::logic_error("affine_impl: size mismatch");
+        }
+        const auto k = coefficients();
+        for(size_t i = 0; i < xs.size(); ++i){
+            const auto x = xs[i];
+            const auto y = ys[i];
+            xs[i] = k[0] * x + k[1] * y + k[2];
+            ys[i] = k[3] * x + k[4] * y + k[5];
+        }
+    }
+    void apply(point_cloud2d_impl<Type> &cloud) const requires (Dim == 2){
+        apply(cloud.xs(), cloud.ys());
+    }
+    void apply(std::span<Type> xs, std::span<Type> ys, std::span<Type> hs) const requires (Dim == 3){
+        if((xs.size() != ys.size()) || (xs.size() != hs.size())){
+            throw std::logic_error("affine_impl: size mismatch");
+        }
+        const auto k = coefficients();
+        for(size_t i = 0; i < xs.size(); ++i){
+            const auto x = xs[i];
+            const auto y = ys[i];
+            const auto h = hs[i];
+            xs[i] = k[0] * x + k[1] * y + k[2] * h + k[3];
+            ys[i] = k[4] * x + k[5] * y + k[6] * h + k[7];
+            hs[i] = k[8] * x + k[9] * y + k[10] * h + k[11];
+        }
+    }
+    void apply(point_cloud3d_impl<Type> &cloud) const requires (Dim == 3){
+        apply(cloud.xs(), cloud.ys(), cloud.hs());
+    }
+
+    //Вершины многоугольника после преобразования. Многоугольник не пересобирается: правильный многоугольник
+    //хранит только центр, сторону и число вершин и потерял бы поворот, а общее преобразование его не сохраняет
+    template<c_polugon Polygon> requires (Dim == 2)
+    std::vector<typename Polygon::type_point> apply(const Polygon &polygon) const{
+        auto points = polygon.get_points();
+        apply(std::span(points));
+        return points;
+    }
+
+    //Окружности и дуги переходят в окружности и дуги только при подобии, иначе - ошибка
+    template<c_circle Circle> requires (Dim == 2)
+    Circle apply(const Circle &circle) const{
+        return Circle(apply(circle.center()), similarity_scale() * circle.radius());
+    }
+
+    //Углы дуги отсчитываются от оси y по часовой стрелке. Отражение меняет направление обхода,
+    //поэтому начало и конец дуги меняются местами
+    template<c_arc Arc> requires (Dim == 2)
+    Arc apply(const Arc &arc) const{
+        const auto scale = similarity_scale();
+        auto start = direction(arc.start());
+        auto stop = direction(arc.stop());
+        if(determinant() < 0){
+            std::swap(start, stop);
+        }
+        return Arc(apply(arc.center()), scale * arc.radius(), start, stop);
+    }
+
+    constexpr friend bool operator==(const affine_impl &transform1, const affine_impl &transform2){
+        return transform1.matrix_ == transform2.matrix_;
+    }
+
+private:
+    //Линейная часть по строкам
+    constexpr std::array<Type, Dim * Dim> linear() const{
+        std::array<Type, Dim * Dim> temp;
+        for(size_t i = 0; i < Dim; ++i){
+            for(size_t j = 0; j < Dim; ++j){
+                temp[i * Dim + j] = matrix_.value(i, j);
+            }
+        }
+        return temp;
+    }
+
+    //Верхние Dim строк матрицы без проверок индексов в цикле применения
+    constexpr std::array<Type, Dim * (Dim + 1)> coefficients() const{
+        std::array<Type, Dim * (Dim + 1)> temp;
+        auto item = matrix_.begin();
+        for(auto &value : temp){
+            value = *item;
+            ++item;
+        }
+        return temp;
+    }
+
+    static constexpr matrix_type fix_last_row(matrix_type m){
+        for(size_t i = 0; i < Dim; ++i){
+            m.value(Dim, i) = Type{};
+        }
+        m.value(Dim, Dim) = Type(1);
+        return m;
+    }
+
+    Type similarity_scale() const{
+        if(!is_similarity()){
+            throw std::logic_error("affine_impl: transform is not a similarity");
+        }
+        return std::sqrt(std::abs(determinant()));
+    }
+
+    //Угол направления angle после преобразования, [0, 2pi)
+    Type direction(Type angle) const{
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle);
+        const auto x = matrix_.value(0, 0) * s + matrix_.value(0, 1) * c;
+        const auto y = matrix_.value(1, 0) * s + matrix_.value(1, 1) * c;
+        auto temp = std::atan2(x, y);
+        return (temp < 0) ? temp + algorithm::pi_in_2<Type> : temp;
+    }
+
+    matrix_type matrix_;
+};
+
+}
+
+#endif // AFFINE_IMPL_H
@@ -0,0 +1,46 @@
+#ifndef ELLIPSOID_IMPL_H
+#define ELLIPSOID_IMPL_H
+
+#include <concepts>
+
+namespace agl {
+
+//Эллипсоид (политика геодезических алгоритмов), задаётся большой и малой полуосями.
+//Все производные константы и постоянные части коэффициентов рядов вычисляются при компиляции
+template<std::floating_point Type, double SemimajorAxis, double SemiminorAxis>
+struct ellipsoid_impl{
+    using type = Type;
+
+    static constexpr Type semimajor_axis = SemimajorAxis;
+    static constexpr Type semiminor_axis = SemiminorAxis;
+    static constexpr Type flattening = (SemimajorAxis - SemiminorAxis) / SemimajorAxis;
+    //!Средний радиус (2a + b) / 3 для сферического приближения
+    static constexpr Type mean_radius = (2.0 * SemimajorAxis + SemiminorAxis) / 3.0;
+
+    //!Первый эксцентриситет в квадрате: (a^2 - b^2) / a^2
+    static constexpr Type eccentricity2 = 1.0 - (SemiminorAxis * SemiminorAxis) / (SemimajorAxis * SemimajorAxis);
+
+    //!(b^2 - a^2) / b^2 и (a^2 - b^2) / b^2 в том виде, в каком они входят в ряды геодезических задач
+    static constexpr Type eccentricity2_1 = 1.0 - (SemimajorAxis * SemimajorAxis) / (SemiminorAxis * SemiminorAxis);
+    static constexpr Type eccentricity2_2 = -eccentricity2_1;
+
+    //!sqrt(1 - eccentricity2_1) = a / b
+    static constexpr Type axis_ratio = SemimajorAxis / SemiminorAxis;
+
+    //!Постоянные части поправки долготы: (c1 - c2 * cos^2(A0)) * q
+    static constexpr Type longitude_c1 = (0.5 + eccentricity2_1 / 8.0) * eccentricity2_1;
+    static constexpr Type longitude_c2 = eccentricity2_1 * eccentricity2_1 / 16.0;
+};
+
+template<std::floating_point Type>
+using wgs84 = ellipsoid_impl<Type, 6378137., 6356752.314245>;     //!1/f = 298.257223563
+
+template<std::floating_point Type>
+using pz90 = ellipsoid_impl<Type, 6378136., 6356751.362>;        //!1/f = 298.25784
+
+template<std::floating_point Type>
+using krasovsky = ellipsoid_impl<Type, 6378245., 6356863.018773>; //!1/f = 298.3
+
+}
+
+#endif // ELLIPSOID_IMPL_H
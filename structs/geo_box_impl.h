@@ -0,0 +1,19 @@
+#ifndef GEO_BOX_IMPL_H
+#define GEO_BOX_IMPL_H
+
+#include <concepts>
+
+namespace agl {
+
+//Прямоугольник в географических координатах (радианы). west > east - прямоугольник пересекает антимеридиан
+template<std::floating_point Type>
+struct geo_box{
+    Type south;
+    Type north;
+    Type west;
+    Type east;
+};
+
+}
+
+#endif // GEO_BOX_IMPL_H
@@ -0,0 +1,285 @@
+#ifndef GEO_INDEX_IMPL_H
+#define GEO_INDEX_IMPL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../algorithm/geo_algorithm.h"
+#include "geo_box_impl.h"
+#include "struct_geo_imp.h"
+
+namespace agl {
+
+//Иерархический индекс ячеек по широте и долготе. Ключ ячейки - код Мортона (чередование битов)
+//квантованных долготы и широты, поэтому ключи ячейки уровня level образуют непрерывный интервал ключей
+//уровня bits. Точки хранятся отсортированными по ключу, запрос сводится к двоичному поиску по интервалам покрытия
+template<c_point2d_geo PointGeo,
+         c_function_angle<typename PointGeo::type_coordinate> ClassFunc = algorithm::function_angle<typename PointGeo::type_coordinate>,
+         c_ellipsoid Ellipsoid = pz90<typename PointGeo::type_coordinate>>
+class geo_index_impl{
+public:
+    using Type = PointGeo::type_coordinate;
+    using key_type = std::uint64_t;
+    using key_range = std::pair<key_type, key_type>;
+
+    static constexpr unsigned bits = 31;      //!Число уровней (битов на ось)
+    static constexpr size_t max_cells = 64;   //!Наибольшее число ячеек в покрытии
+
+    geo_index_impl() = default;
+    explicit geo_index_impl(const std::vector<PointGeo> &points){
+        build(points);
+    }
+
+    void build(const std::vector<PointGeo> &points){
+        std::vector<std::pair<key_type, size_t>> items;
+        items.reserve(points.size());
+        for(size_t i = 0; i < points.size(); ++i){
+            items.emplace_back(cell(points[i]), i);
+        }
+        std::ranges::sort(items);
+        keys_.resize(items.size());
+        order_.resize(items.size());
+        latitude_.resize(items.size());
+        longitude_.resize(items.size());
+        for(size_t i = 0; i < items.size(); ++i){
+            const auto &point = points[items[i].second];
+            keys_[i] = items[i].first;
+            order_[i] = items[i].second;
+            latitude_[i] = static_cast<Type>(point.latitude());
+            longitude_[i] = normalize(static_cast<Type>(point.longitude()));
+        }
+    }
+
+    size_t size() const{
+        return keys_.size();
+    }
+    bool empty() const{
+        return keys_.empty();
+    }
+
+    //Ключ ячейки уровня level, содержащей точку
+    static constexpr key_type cell(const PointGeo &point, unsigned level = bits){
+        const auto key = interleave(quantize_longitude(static_cast<Type>(point.longitude())),
+                                    quantize_latitude(static_cast<Type>(point.latitude())));
+        return key >> (2 * (bits - level));
+    }
+
+    //Покрытие прямоугольника ячейками: непересекающиеся интервалы ключей уровня bits [first, second)
+    static std::vector<key_range> cover(const geo_box<Type> &box){
+        const auto south = quantize_latitude(box.south);
+        const auto north = quantize_latitude(box.north);
+        const auto west = quantize_longitude(box.west);
+        const auto east = (box.east >= algorithm::pi<Type>) ? (key_type(1) << bits) - 1 : quantize_longitude(box.east);
+        const auto crossing = west > east;
+
+        //Самый мелкий уровень, на котором покрытие укладывается в max_cells ячеек
+        unsigned level = bits;
+        for(; level > 0; --level){
+            const auto shift = bits - level;
+            const auto count_lat = (north >> shift) - (south >> shift) + 1;
+            const auto count_lon = crossing ? (key_type(1) << level) - (west >> shift) + (east >> shift) + 1
+                                            : (east >> shift) - (west >> shift) + 1;
+            if(count_lat * count_lon <= max_cells){
+                break;
+            }
+        }
+        const auto shift = bits - level;
+        const auto last = (key_type(1) << level) - 1;
+        std::vector<key_range> ranges;
+        auto add = [&ranges, shift](key_type lon_first, key_type lon_last, key_type lat){
+            for(auto lon = lon_first; lon <= lon_last; ++lon){
+                const auto key = interleave(lon, lat);
+                ranges.emplace_back(key << (2 * shift), (key + 1) << (2 * shift));
+            }
+        };
+        for(auto lat = south >> shift; lat <= (north >> shift); ++lat){
+            if(crossing){
+                add(west >> shift, last, lat);
+                add(0, east >> shift, lat);
+            }
+            else{
+                add(west >> shift, east >> shift, lat);
+            }
+        }
+        std::ranges::sort(ranges);
+        std::vector<key_range> merged;
+        for(const auto &range : ranges){
+            if(!merged.empty() && (merged.back().second >= range.first)){
+                merged.back().second = std::max(merged.back().second, range.second);
+            }
+            else{
+                merged.push_back(range);
+            }
+        }
+        return merged;
+    }
+
+    //Прямоугольник, гарантированно содержащий круг (с запасом на расхождение сферы и эллипсоида)
+    template<c_circle Circle>
+    static geo_box<Type> bounding_box(const Circle &circle){
+        const auto center = circle.center();
+        const auto latitude = static_cast<Type>(center.latitude());
+        const auto longitude = static_cast<Type>(center.longitude());
+        const auto delta = angular_radius(static_cast<Type>(circle.radius()));
+        const auto south = latitude - delta;
+        const auto north = latitude + delta;
+        if((north >= algorithm::pi_on_2<Type>) || (south <= -algorithm::pi_on_2<Type>)){
+            return {std::max(south, -algorithm::pi_on_2<Type>), std::min(north, algorithm::pi_on_2<Type>),
+                    -algorithm::pi<Type>, algorithm::pi<Type>};
+        }
+        const auto ratio = ClassFunc::sin(delta) / ClassFunc::cos(latitude);
+        if(ratio >= 1){
+            return {south, north, -algorithm::pi<Type>, algorithm::pi<Type>};
+        }
+        const auto dlon = ClassFunc::asin(ratio);
+        return {south, north, normalize(longitude - dlon), normalize(longitude + dlon)};
+    }
+
+    template<c_circle Circle>
+    static std::vector<key_range> cover(const Circle &circle){
+        return cover(bounding_box(circle));
+    }
+
+    //Индексы точек внутри прямоугольника
+    std::vector<size_t> range(const geo_box<Type> &box) const{
+        std::vector<size_t> temp;
+        visit(cover(box), [&temp, &box, this](size_t i){
+            const auto longitude = longitude_[i];
+            const auto inside_lon = (box.west <= box.east) ? (box.west <= longitude) && (longitude <= box.east)
+                                                           : (box.west <= longitude) || (longitude <= box.east);
+            if(inside_lon && (box.south <= latitude_[i]) && (latitude_[i] <= box.north)){
+                temp.push_back(order_[i]);
+            }
+        });
+        return temp;
+    }
+
+    //Индексы точек, дальность до которых от центра круга меньше радиуса
+    template<c_circle Circle>
+    std::vector<size_t> range(const Circle &circle) const{
+        std::vector<size_t> temp;
+        const auto center = circle.center();
+        const auto radius = static_cast<Type>(circle.radius());
+        const auto band = radius * geo_algo::spherical_error<Type>;
+        const auto cos_latitude = ClassFunc::cos(static_cast<Type>(center.latitude()));
+        //Гаверсинус углового расстояния монотонен, поэтому пороги сравниваются без обратных функций
+        const auto inner = haversine(std::max(radius - band, Type()) / Ellipsoid::mean_radius);
+        const auto outer = haversine(std::min((radius + band) / Ellipsoid::mean_radius, algorithm::pi<Type>));
+        visit(cover(circle), [&](size_t i){
+            const auto h = haversine(latitude_[i] - static_cast<Type>(center.latitude()))
+                           + cos_latitude * ClassFunc::cos(latitude_[i]) * haversine(longitude_[i] - static_cast<Type>(center.longitude()));
+            if(h < inner){
+                temp.push_back(order_[i]);
+            }
+            else if((h <= outer) && (distance(center, i) < radius)){
+                temp.push_back(order_[i]);
+            }
+        });
+        return temp;
+    }
+
+    //count ближайших точек в порядке возрастания дальности (пары индекс - дальность)
+    std::vector<std::pair<size_t, Type>> nearest(const PointGeo &point, size_t count, Type radius = 1000.) const{
+        std::vector<std::pair<size_t, Type>> temp;
+        count = std::min(count, size());
+        if(count == 0){
+            return temp;
+        }
+        constexpr auto limit = algorithm::pi<Type> * Ellipsoid::semimajor_axis;
+        for(;; radius *= 4){
+            temp.clear();
+            const auto full = radius >= limit;
+            if(full){
+                for(size_t i = 0; i < size(); ++i){
+                    temp.emplace_back(order_[i], distance(point, i));
+                }
+            }
+            else{
+                visit(cover(circle_geo_impl<Type, PointGeo>(point, radius)), [&temp, &point, this](size_t i){
+                    temp.emplace_back(order_[i], distance(point, i));
+                });
+            }
+            //Покрытие содержит все точки ближе radius, значит найденные count ближайших точные
+            if(full || (temp.size() >= count)){
+                std::ranges::sort(temp, std::less{}, &std::pair<size_t, Type>::second);
+                if(full || (temp[count - 1].second < radius)){
+                    temp.resize(count);
+                    return temp;
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr Type normalize(Type longitude){
+        const auto turn = 2 * algorithm::pi<Type>;
+        return longitude - turn * std::floor((longitude + algorithm::pi<Type>) / turn);
+    }
+
+    static constexpr key_type quantize_latitude(Type latitude){
+        constexpr auto scale = Type(key_type(1) << bits) / algorithm::pi<Type>;
+        const auto value = std::floor((latitude + algorithm::pi_on_2<Type>) * scale);
+        return static_cast<key_type>(std::clamp(value, Type(), Type((key_type(1) << bits) - 1)));
+    }
+
+    static constexpr key_type quantize_longitude(Type longitude){
+        constexpr auto scale = Type(key_type(1) << bits) / (2 * algorithm::pi<Type>);
+        const auto value = std::floor((normalize(longitude) + algorithm::pi<Type>) * scale);
+        return static_cast<key_type>(std::clamp(value, Type(), Type((key_type(1) << bits) - 1)));
+    }
+
+    //Раздвигает биты: bit i переходит в bit 2i
+    static constexpr key_type spread(key_type value){
+        value &= 0xffffffff;
+        value = (value | (value << 16)) & 0x0000ffff0000ffff;
+        value = (value | (value << 8)) & 0x00ff00ff00ff00ff;
+        value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0f;
+        value = (value | (value << 2)) & 0x3333333333333333;
+        value = (value | (value << 1)) & 0x5555555555555555;
+        return value;
+    }
+
+    static constexpr key_type interleave(key_type longitude, key_type latitude){
+        return spread(longitude) | (spread(latitude) << 1);
+    }
+
+    static constexpr Type haversine(Type angle){
+        const auto value = ClassFunc::sin(angle / 2);
+        return value * value;
+    }
+
+    //Угловой радиус, заведомо не меньший угла дальности range на эллипсоиде
+    static constexpr Type angular_radius(Type range){
+        return range * (1 + 2 * geo_algo::spherical_error<Type>) / Ellipsoid::mean_radius;
+    }
+
+    Type distance(const PointGeo &point, size_t i) const{
+        using Angle = PointGeo::type_coordinate;
+        return std::get<0>(geo_algo::geographic_inverse<PointGeo, ClassFunc, Ellipsoid>(
+            point, PointGeo(Angle(latitude_[i]), Angle(longitude_[i]))));
+    }
+
+    template<typename Func>
+    void visit(const std::vector<key_range> &ranges, Func &&func) const{
+        auto begin = keys_.begin();
+        for(const auto &[first, last] : ranges){
+            begin = std::lower_bound(begin, keys_.end(), first);
+            const auto end = std::lower_bound(begin, keys_.end(), last);
+            for(auto it = begin; it != end; ++it){
+                func(static_cast<size_t>(it - keys_.begin()));
+            }
+            begin = end;
+        }
+    }
+
+    std::vector<key_type> keys_;
+    std::vector<size_t> order_;
+    std::vector<Type> latitude_;
+    std::vector<Type> longitude_;
+};
+
+}
+
+#endif // GEO_INDEX_IMPL_H
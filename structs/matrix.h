@@ -6,9 +6,12 @@
 #include <cassert>
 #include <format>
 #include <iostream>
+#include <span>
+#include <vector>
 
 #include "../iterator/matrix_iterator.h"
 #include "../algorithm/matrix_algorithm.h"
+#include "matrix_view.h"
 
 namespace agl {
 
@@ -28,16 +31,16 @@ public:
     using const_iterator_column = matrix_column_iterator<const Type, Row, Col>;
 
     constexpr iterator begin(){
-        return iterator(std::begin(*data_.begin()));
+        return iterator(data_.data());
     }
     constexpr iterator end(){
-        return iterator(std::begin(*data_.end()));
+        return iterator(data_.data() + Row * Col);
     }
     constexpr const_iterator begin() const{
-        return const_iterator(std::begin(*data_.begin()));
+        return const_iterator(data_.data());
     }
     constexpr const_iterator end() const{
-        return const_iterator(std::begin(*data_.end()));
+        return const_iterator(data_.data() + Row * Col);
     }
     constexpr const_iterator cbegin() const{
         return begin();
@@ -47,16 +50,16 @@ public:
     }
 
     constexpr iterator_row begin_row(size_t column = 0){
-        return iterator_row(std::next(std::begin(*data_.begin()), column));
+        return iterator_row(data_.data() + column);
     }
     constexpr iterator_row end_row(size_t column = 0){
-        return iterator_row(std::next(std::begin(*data_.end()), column));
+        return iterator_row(data_.data() + Row * Col + column);
     }
     constexpr const_iterator_row begin_row(size_t column = 0) const{
-        return const_iterator_row(std::next(std::begin(*data_.begin()), column));
+        return const_iterator_row(data_.data() + column);
     }
     constexpr const_iterator_row end_row(size_t column = 0) const{
-        return const_iterator_row(std::next(std::begin(*data_.end()), column));
+        return const_iterator_row(data_.data() + Row * Col + column);
     }
     constexpr const_iterator_row cbegin_row(size_t column = 0) const{
         return begin_row(column);
@@ -66,16 +69,16 @@ public:
     }
 
     constexpr iterator_column begin_column(size_t row = 0){
-        return iterator_column(std::begin(*std::next(data_.begin(), row)));
+        return iterator_column(data_.data() + row * Col);
     }
     constexpr iterator_column end_column(size_t row = 0){
-        return iterator_column(std::next(std::begin(*std::next(data_.begin(), row)), Col));
+        return iterator_column(data_.data() + (row + 1) * Col);
     }
     constexpr const_iterator_column begin_column(size_t row = 0) const{
-        return const_iterator_column(std::begin(*std::next(data_.begin(), row)));
+        return const_iterator_column(data_.data() + row * Col);
     }
     constexpr const_iterator_column end_column(size_t row = 0) const{
-        return const_iterator_column(std::next(std::begin(*std::next(data_.begin(), row)), Col));
+        return const_iterator_column(data_.data() + (row + 1) * Col);
     }
     constexpr const_iterator_column cbegin_column(size_t row = 0) const{
         return begin_column(row);
@@ -87,6 +90,8 @@ public:
     constexpr matrix(){
         std::ranges::fill(*this, Type{});
     }
+    //Элементы не заполняются: для результатов, которые сразу перезаписываются целиком
+    constexpr explicit matrix(uninitialized_t){}
     constexpr matrix(std::initializer_list<Type> list){
         if(list.size() < Row * Col){
             std::copy(list.begin(), list.end(), begin());
@@ -104,8 +109,20 @@ public:
         return Col;
     }
 
+    //Элементы по строкам без копирования
+    constexpr Type *data(){
+        return data_.data();
+    }
+    constexpr const Type *data() const{
+        return data_.data();
+    }
+
     constexpr matrix_array get(){
-        return data_;
+        matrix_array temp;
+        for(size_t r = 0; r < Row; ++r){
+            std::ranges::copy(begin_column(r), end_column(r), temp[r].begin());
+        }
+        return temp;
     }
 
     constexpr std::array<Type, Col> row(size_t r) const{
@@ -127,6 +144,32 @@ public:
         return array;
     }
 
+    //Строка и столбец без копирования
+    constexpr std::span<Type, Col> row_view(size_t r){
+        if(r >= Row){
+            throw std::logic_error(std::format("Index error row = {}", r));
+        }
+        return std::span<Type, Col>(data_.data() + r * Col, Col);
+    }
+    constexpr std::span<const Type, Col> row_view(size_t r) const{
+        if(r >= Row){
+            throw std::logic_error(std::format("Index error row = {}", r));
+        }
+        return std::span<const Type, Col>(data_.data() + r * Col, Col);
+    }
+    constexpr std::ranges::subrange<iterator_row> column_view(size_t c){
+        if(c >= Col){
+            throw std::logic_error(std::format("Index error row = {}", c));
+        }
+        return {begin_row(c), end_row(c)};
+    }
+    constexpr std::ranges::subrange<const_iterator_row> column_view(size_t c) const{
+        if(c >= Col){
+            throw std::logic_error(std::format("Index error row = {}", c));
+        }
+        return {begin_row(c), end_row(c)};
+    }
+
     constexpr void swap_row(size_t row1, size_t row2){
         if(row1 >= Row){
             throw std::logic_error(std::format("Index error row = {}", row1));
@@ -134,7 +177,7 @@ public:
         if(row2 >= Row){
             throw std::logic_error(std::format("Index error row = {}", row2));
         }
-        data_[row1].swap(data_[row2]);
+        std::swap_ranges(begin_column(row1), end_column(row1), begin_column(row2));
     }
     constexpr void swap_column(size_t col1, size_t col2){
         if(col1 >= Col){
@@ -153,13 +196,13 @@ public:
         if(row2 >= Row){
             throw std::logic_error(std::format("Index error row = {}", row2));
         }
-        data_[row1] = data_[row2];
+        std::ranges::copy(begin_column(row2), end_column(row2), begin_column(row1));
     }
     constexpr void copy_row(size_t row, const std::array<Type, Col> &array){
         if(row >= Row){
             throw std::logic_error(std::format("Index error row = {}", row));
         }
-        data_[row] = array;
+        std::ranges::copy(array, begin_column(row));
     }
     constexpr void copy_column(size_t col1, size_t col2){
         if(col1 >= Col){
@@ -181,13 +224,21 @@ public:
         if((r >= Row) || (c >= Col)){
             throw std::logic_error(std::format("Index error row = {}, column = {}", r, c));
         }
-        return data_.at(r).at(c);
+        return data_[r * Col + c];
     }
     constexpr Type value(size_t r, size_t c) const{
         if((r >= Row) || (c >= Col)){
             throw std::logic_error(std::format("Index error row = {}, column = {}", r, c));
         }
-        return data_.at(r).at(c);
+        return data_[r * Col + c];
+    }
+
+    //Представление элементов без копирования для matrix_algo и внешних буферов
+    constexpr matrix_view<Type, Row, Col> view(){
+        return matrix_view<Type, Row, Col>(data_.data());
+    }
+    constexpr matrix_view<const Type, Row, Col> view() const{
+        return matrix_view<const Type, Row, Col>(data_.data());
     }
 
     constexpr Type determinant() const requires (Row == Col){
@@ -199,14 +250,14 @@ public:
     }
 
     constexpr friend auto operator+(const matrix<Type, Row, Col> &m1, const matrix<Type, Row, Col> &m2) -> matrix<Type, Row, Col>{
-        matrix<Type, Row, Col> temp;
-        std::ranges::transform(m1, m2, temp.begin(), std::plus{});
+        matrix<Type, Row, Col> temp(uninitialized);
+        matrix_algo::add_into(m1, m2, temp);
         return temp;
     }
 
     constexpr friend auto operator-(const matrix<Type, Row, Col> &m1, const matrix<Type, Row, Col> &m2) -> matrix<Type, Row, Col>{
-        matrix<Type, Row, Col> temp;
-        std::ranges::transform(m1, m2, temp.begin(), std::minus{});
+        matrix<Type, Row, Col> temp(uninitialized);
+        matrix_algo::sub_into(m1, m2, temp);
         return temp;
     }
 
@@ -243,15 +294,114 @@ public:
     }
 
     constexpr friend std::ostream& operator<<(std::ostream& os, const matrix &m){
-        for(auto &i : m.data_){
-            std::copy(i.begin(), i.end(), std::ostream_iterator<Type>(os, " "));
+        for(size_t r = 0; r < Row; ++r){
+            std::copy(m.begin_column(r), m.end_column(r), std::ostream_iterator<Type>(os, " "));
             os << "\n";
         }
         return os;
     }
 
 private:
-    matrix_array data_;
+    std::array<Type, Row * Col> data_;   //!Элементы по строкам
+};
+
+//Матрица с размерами, задаваемыми при выполнении. Элементы хранятся по строкам в непрерывном массиве
+template<typename Type> requires std::is_floating_point_v<Type> || std::is_integral_v<Type>
+class dynamic_matrix{
+public:
+    using type = Type;
+
+    dynamic_matrix() = default;
+    dynamic_matrix(size_t rows, size_t columns, Type value = Type{})
+        : rows_(rows), columns_(columns), data_(rows * columns, value){}
+
+    size_t rows() const{
+        return rows_;
+    }
+    size_t columns() const{
+        return columns_;
+    }
+    //Шаг между строками в элементах
+    size_t stride() const{
+        return columns_;
+    }
+
+    void resize(size_t rows, size_t columns, Type value = Type{}){
+        rows_ = rows;
+        columns_ = columns;
+        data_.assign(rows * columns, value);
+    }
+
+    Type *data(){
+        return data_.data();
+    }
+    const Type *data() const{
+        return data_.data();
+    }
+    auto begin(){
+        return data_.begin();
+    }
+    auto end(){
+        return data_.end();
+    }
+    auto begin() const{
+        return data_.begin();
+    }
+    auto end() const{
+        return data_.end();
+    }
+
+    std::span<Type> row(size_t r){
+        if(r >= rows_){
+            throw std::logic_error(std::format("Index error row = {}", r));
+        }
+        return std::span<Type>(data_).subspan(r * columns_, columns_);
+    }
+    std::span<const Type> row(size_t r) const{
+        if(r >= rows_){
+            throw std::logic_error(std::format("Index error row = {}", r));
+        }
+        return std::span<const Type>(data_).subspan(r * columns_, columns_);
+    }
+
+    matrix_view<Type> view(){
+        return matrix_view<Type>(data_.data(), rows_, columns_);
+    }
+    matrix_view<const Type> view() const{
+        return matrix_view<const Type>(data_.data(), rows_, columns_);
+    }
+
+    Type &value(size_t r, size_t c){
+        if((r >= rows_) || (c >= columns_)){
+            throw std::logic_error(std::format("Index error row = {}, column = {}", r, c));
+        }
+        return data_[r * columns_ + c];
+    }
+    Type value(size_t r, size_t c) const{
+        if((r >= rows_) || (c >= columns_)){
+            throw std::logic_error(std::format("Index error row = {}, column = {}", r, c));
+        }
+        return data_[r * columns_ + c];
+    }
+
+    friend bool operator==(const dynamic_matrix &m1, const dynamic_matrix &m2){
+        if((m1.rows_ != m2.rows_) || (m1.columns_ != m2.columns_)){
+            return false;
+        }
+        if constexpr(std::is_floating_point_v<Type>){
+            return std::ranges::equal(m1.data_, m2.data_, [](const auto &i, const auto &j){
+                return algorithm::compare(i, j);
+            });
+        }
+        else{
+            return m1.data_ == m2.data_;
+        }
+    }
+
+private:
+    size_t rows_{};
+    size_t columns_{};
+    std::vector<Type> data_;
 };
 
 }
@@ -0,0 +1,303 @@
+#ifndef MATRIX_BATCH_H
+#define MATRIX_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "matrix.h"
+
+namespace agl {
+
+//Пакет независимых матриц Row x Col одного размера в раскладке "матрица дорожек": матрицы разбиты на блоки
+//по Lanes штук, внутри блока элемент (i, j) всех Lanes матриц лежит подряд. Пакетные функции проходят
+//по элементам, а внутренний цикл фиксированной длины Lanes идёт по матрицам и векторизуется компилятором.
+//Хвост последнего блока заполнен единичными матрицами (нулями для неквадратных), чтобы не порождать NaN
+template<std::floating_point Type, size_t Row, size_t Col, size_t Lanes = 8>
+class matrix_batch{
+public:
+    using type = Type;
+    static constexpr size_t lanes = Lanes;
+    static constexpr size_t block_size = Row * Col * Lanes;   //!Элементов в блоке
+
+    matrix_batch() = default;
+    explicit matrix_batch(size_t count){
+        resize(count);
+    }
+    explicit matrix_batch(std::span<const matrix<Type, Row, Col>> matrices){
+        load(matrices);
+    }
+
+    void resize(size_t count){
+        size_ = count;
+        data_.assign((count + Lanes - 1) / Lanes * block_size, Type{});
+        if constexpr(Row == Col){
+            for(size_t index = count; index < blocks() * Lanes; ++index){
+                for(size_t i = 0; i < Row; ++i){
+                    value(index, i, i) = Type(1);
+                }
+            }
+        }
+    }
+
+    size_t size() const{
+        return size_;
+    }
+    bool empty() const{
+        return size_ == 0;
+    }
+    size_t blocks() const{
+        return data_.size() / block_size;
+    }
+
+    //Элементы блока b: block(b)[(i * Col + j) * Lanes + lane]
+    Type *block(size_t b){
+        return data_.data() + b * block_size;
+    }
+    const Type *block(size_t b) const{
+        return data_.data() + b * block_size;
+    }
+
+    Type &value(size_t index, size_t r, size_t c){
+        return data_[offset(index, r, c)];
+    }
+    Type value(size_t index, size_t r, size_t c) const{
+        return data_[offset(index, r, c)];
+    }
+
+    matrix<Type, Row, Col> get(size_t index) const{
+        if(index >= size_){
+            throw std::logic_error(std::format("Index error matrix = {}", index));
+        }
+        matrix<Type, Row, Col> temp(uninitialized);
+        auto item = temp.begin();
+        for(size_t k = 0; k < Row * Col; ++k, ++item){
+            *item = data_[(index / Lanes) * block_size + k * Lanes + index % Lanes];
+        }
+        return temp;
+    }
+    void set(size_t index, const matrix<Type, Row, Col> &m){
+        if(index >= size_){
+            throw std::logic_error(std::format("Index error matrix = {}", index));
+        }
+        auto item = m.begin();
+        for(size_t k = 0; k < Row * Col; ++k, ++item){
+            data_[(index / Lanes) * block_size + k * Lanes + index % Lanes] = *item;
+        }
+    }
+
+    //Загрузка из массива матриц и выгрузка в него
+    void load(std::span<const matrix<Type, Row, Col>> matrices){
+        resize(matrices.size());
+        for(size_t i = 0; i < matrices.size(); ++i){
+            set(i, matrices[i]);
+        }
+    }
+    void store(std::span<matrix<Type, Row, Col>> matrices) const{
+        if(matrices.size() < size_){
+            throw std::logic_error("matrix_batch: output is too small");
+        }
+        for(size_t i = 0; i < size_; ++i){
+            matrices[i] = get(i);
+        }
+    }
+    std::vector<matrix<Type, Row, Col>> store() const{
+        std::vector<matrix<Type, Row, Col>> temp(size_);
+        store(std::span(temp));
+        return temp;
+    }
+
+private:
+    size_t offset(size_t index, size_t r, size_t c) const{
+        if((index >= blocks() * Lanes) || (r >= Row) || (c >= Col)){
+            throw std::logic_error(std::format("Index error matrix = {}, row = {}, column = {}", index, r, c));
+        }
+        return (index / Lanes) * block_size + (r * Col + c) * Lanes + index % Lanes;
+    }
+
+    size_t size_{};
+    std::vector<Type> data_;
+};
+
+namespace matrix_algo{
+
+//Пакетное умножение: result[k] = m1[k] * m2[k]
+template<std::floating_point Type, size_t R, size_t K, size_t C, size_t Lanes>
+void mul(const matrix_batch<Type, R, K, Lanes> &m1, const matrix_batch<Type, K, C, Lanes> &m2,
+         matrix_batch<Type, R, C, Lanes> &result){
+    if(m1.size() != m2.size()){
+        throw std::logic_error("matrix_batch: size mismatch");
+    }
+    result.resize(m1.size());
+    for(size_t b = 0; b < m1.blocks(); ++b){
+        const auto *a = m1.block(b);
+        const auto *x = m2.block(b);
+        auto *out = result.block(b);
+        for(size_t i = 0; i < R; ++i){
+            for(size_t j = 0; j < C; ++j){
+                Type sum[Lanes]{};
+                for(size_t k = 0; k < K; ++k){
+                    const auto *u = a + (i * K + k) * Lanes;
+                    const auto *v = x + (k * C + j) * Lanes;
+                    for(size_t l = 0; l < Lanes; ++l){
+                        sum[l] += u[l] * v[l];
+                    }
+                }
+                std::copy(sum, sum + Lanes, out + (i * C + j) * Lanes);
+            }
+        }
+    }
+}
+
+namespace {
+
+//LU-разложение блока с выбором главного элемента по столбцу отдельно для каждой матрицы.
+//Перестановки строк скалярные (O(N^2) на матрицу), исключение - по дорожкам (O(N^3)).
+//Правые части rhs (N x C) преобразуются вместе с матрицей, inverse_pivot - обратные ведущие элементы,
+//для вырожденной матрицы ведущий элемент заменяется нулём обратного, флаг valid сбрасывается
+template<std::floating_point Type, size_t N, size_t C, size_t Lanes>
+void lu_block(Type *a, Type *rhs, Type *inverse_pivot, Type *det, bool *valid){
+    for(size_t l = 0; l < Lanes; ++l){
+        det[l] = Type(1);
+        valid[l] = true;
+    }
+    for(size_t k = 0; k < N; ++k){
+        for(size_t l = 0; l < Lanes; ++l){
+            size_t pivot = k;
+            for(size_t r = k + 1; r < N; ++r){
+                if(std::abs(a[(r * N + k) * Lanes + l]) > std::abs(a[(pivot * N + k) * Lanes + l])){
+                    pivot = r;
+                }
+            }
+            if(pivot != k){
+                for(size_t c = 0; c < N; ++c){
+                    std::swap(a[(k * N + c) * Lanes + l], a[(pivot * N + c) * Lanes + l]);
+                }
+                for(size_t c = 0; c < C; ++c){
+                    std::swap(rhs[(k * C + c) * Lanes + l], rhs[(pivot * C + c) * Lanes + l]);
+                }
+                det[l] = -det[l];
+            }
+        }
+        const auto *row = a + (k * N) * Lanes;
+        for(size_t l = 0; l < Lanes; ++l){
+            const auto pivot = row[k * Lanes + l];
+            const auto singular = algorithm::compare(pivot, Type{});
+            valid[l] = valid[l] && !singular;
+            det[l] *= pivot;
+            inverse_pivot[k * Lanes + l] = singular ? Type{} : Type(1) / pivot;
+        }
+        for(size_t r = k + 1; r < N; ++r){
+            Type factor[Lanes];
+            for(size_t l = 0; l < Lanes; ++l){
+                factor[l] = a[(r * N + k) * Lanes + l] * inverse_pivot[k * Lanes + l];
+            }
+            for(size_t c = k + 1; c < N; ++c){
+                auto *out = a + (r * N + c) * Lanes;
+                const auto *in = row + c * Lanes;
+                for(size_t l = 0; l < Lanes; ++l){
+                    out[l] -= factor[l] * in[l];
+                }
+            }
+            for(size_t c = 0; c < C; ++c){
+                auto *out = rhs + (r * C + c) * Lanes;
+                const auto *in = rhs + (k * C + c) * Lanes;
+                for(size_t l = 0; l < Lanes; ++l){
+                    out[l] -= factor[l] * in[l];
+                }
+            }
+        }
+    }
+}
+
+//Обратная подстановка для верхнетреугольного блока после lu_block
+template<std::floating_point Type, size_t N, size_t C, size_t Lanes>
+void back_substitution(const Type *a, Type *rhs, const Type *inverse_pivot){
+    for(size_t k = N; k-- > 0;){
+        for(size_t c = 0; c < C; ++c){
+            auto *out = rhs + (k * C + c) * Lanes;
+            for(size_t j = k + 1; j < N; ++j){
+                const auto *u = a + (k * N + j) * Lanes;
+                const auto *v = rhs + (j * C + c) * Lanes;
+                for(size_t l = 0; l < Lanes; ++l){
+                    out[l] -= u[l] * v[l];
+                }
+            }
+            for(size_t l = 0; l < Lanes; ++l){
+                out[l] *= inverse_pivot[k * Lanes + l];
+            }
+        }
+    }
+}
+
+}
+
+//Пакетное решение систем m[k] * x[k] = rhs[k]. Возвращает признак невырожденности для каждой системы
+template<std::floating_point Type, size_t N, size_t C, size_t Lanes>
+std::vector<bool> solve(const matrix_batch<Type, N, N, Lanes> &m, const matrix_batch<Type, N, C, Lanes> &rhs,
+                        matrix_batch<Type, N, C, Lanes> &result){
+    if(m.size() != rhs.size()){
+        throw std::logic_error("matrix_batch: size mismatch");
+    }
+    result = rhs;
+    std::vector<bool> temp(m.size());
+    std::vector<Type> a(m.block_size);
+    Type inverse_pivot[N * Lanes];
+    Type det[Lanes];
+    bool valid[Lanes];
+    for(size_t b = 0; b < m.blocks(); ++b){
+        std::copy(m.block(b), m.block(b) + m.block_size, a.begin());
+        lu_block<Type, N, C, Lanes>(a.data(), result.block(b), inverse_pivot, det, valid);
+        back_substitution<Type, N, C, Lanes>(a.data(), result.block(b), inverse_pivot);
+        for(size_t l = 0; (l < Lanes) && (b * Lanes + l < m.size()); ++l){
+            temp[b * Lanes + l] = valid[l];
+        }
+    }
+    return temp;
+}
+
+//Пакетное обращение. Для вырожденных матриц результат не определён, признак - false
+template<std::floating_point Type, size_t N, size_t Lanes>
+std::vector<bool> inverse_matrix(const matrix_batch<Type, N, N, Lanes> &m, matrix_batch<Type, N, N, Lanes> &result){
+    matrix_batch<Type, N, N, Lanes> identity(m.size());
+    for(size_t b = 0; b < identity.blocks(); ++b){
+        for(size_t i = 0; i < N; ++i){
+            std::fill_n(identity.block(b) + (i * N + i) * Lanes, Lanes, Type(1));
+        }
+    }
+    return solve(m, identity, result);
+}
+
+//Пакетный определитель
+template<std::floating_point Type, size_t N, size_t Lanes>
+void determinant(const matrix_batch<Type, N, N, Lanes> &m, std::span<Type> result){
+    if(result.size() < m.size()){
+        throw std::logic_error("matrix_batch: output is too small");
+    }
+    std::vector<Type> a(m.block_size);
+    Type inverse_pivot[N * Lanes];
+    Type det[Lanes];
+    bool valid[Lanes];
+    for(size_t b = 0; b < m.blocks(); ++b){
+        std::copy(m.block(b), m.block(b) + m.block_size, a.begin());
+        lu_block<Type, N, 0, Lanes>(a.data(), nullptr, inverse_pivot, det, valid);
+        for(size_t l = 0; (l < Lanes) && (b * Lanes + l < m.size()); ++l){
+            result[b * Lanes + l] = valid[l] ? det[l] : Type{};
+        }
+    }
+}
+
+template<std::floating_point Type, size_t N, size_t Lanes>
+std::vector<Type> determinant(const matrix_batch<Type, N, N, Lanes> &m){
+    std::vector<Type> temp(m.size());
+    determinant(m, std::span(temp));
+    return temp;
+}
+
+}
+
+}
+
+#endif // MATRIX_BATCH_H
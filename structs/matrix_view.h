@@ -0,0 +1,416 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../algorithm/matrix_algorithm.h"
+
+namespace agl {
+
+//Раскладка по строкам, как в agl::matrix: соседние элементы строки лежат подряд
+struct layout_right{};
+//Раскладка по столбцам (Fortran, BLAS, LAPACK)
+struct layout_left{};
+//Произвольные шаги строк и столбцов: подматрицы, строки с выравниванием, чередующиеся каналы
+struct layout_stride{};
+
+template<typename Layout>
+concept c_matrix_layout = std::is_same_v<Layout, layout_right> || std::is_same_v<Layout, layout_left>
+                          || std::is_same_v<Layout, layout_stride>;
+
+//Невладеющее представление матрицы над чужим буфером (по образцу std::mdspan).
+//Размер, известный при компиляции, задаётся параметром Row/Col, иначе std::dynamic_extent.
+//Копирование представления не копирует элементы
+template<typename Type, size_t Row = std::dynamic_extent, size_t Col = std::dynamic_extent, c_matrix_layout Layout = layout_right>
+    requires std::is_floating_point_v<std::remove_const_t<Type>> || std::is_integral_v<std::remove_const_t<Type>>
+class matrix_view{
+public:
+    using type = std::remove_const_t<Type>;
+    using element_type = Type;
+    using layout_type = Layout;
+    using pointer = Type*;
+    using reference = Type&;
+
+    static constexpr size_t static_rows = Row;
+    static constexpr size_t static_columns = Col;
+
+    constexpr explicit matrix_view(pointer data)
+        requires (Row != std::dynamic_extent) && (Col != std::dynamic_extent) && (!std::is_same_v<Layout, layout_stride>)
+        : matrix_view(data, Row, Col){}
+
+    constexpr matrix_view(pointer data, size_t rows, size_t columns) requires (!std::is_same_v<Layout, layout_stride>)
+        : data_(data), rows_(rows), columns_(columns){
+        check_extents();
+        if constexpr(std::is_same_v<Layout, layout_right>){
+            strides_ = {columns, 1};
+        }
+        else{
+            strides_ = {1, rows};
+        }
+    }
+
+    //Буфер должен вмещать все элементы
+    constexpr matrix_view(std::span<Type> data, size_t rows, size_t columns) requires (!std::is_same_v<Layout, layout_stride>)
+        : matrix_view(data.data(), rows, columns){
+        if(data.size() < rows * columns){
+            throw std::logic_error("matrix_view: buffer is too small");
+        }
+    }
+
+    //strides - шаг между строками и шаг между столбцами в элементах
+    constexpr matrix_view(pointer data, size_t rows, size_t columns, std::array<size_t, 2> strides)
+        requires std::is_same_v<Layout, layout_stride>
+        : data_(data), rows_(rows), columns_(columns), strides_(strides){
+        check_extents();
+    }
+
+    //Из представления изменяемых элементов и/или с известным при компиляции размером
+    template<typename Other, size_t Row2, size_t Col2>
+        requires std::is_convertible_v<Other(*)[], Type(*)[]>
+                 && ((Row == std::dynamic_extent) || (Row == Row2)) && ((Col == std::dynamic_extent) || (Col == Col2))
+    constexpr matrix_view(const matrix_view<Other, Row2, Col2, Layout> &view)
+        : data_(view.data()), rows_(view.rows()), columns_(view.columns()), strides_{view.stride(0), view.stride(1)}{}
+
+    constexpr size_t rows() const{
+        if constexpr(Row != std::dynamic_extent){
+            return Row;
+        }
+        else{
+            return rows_;
+        }
+    }
+    constexpr size_t columns() const{
+        if constexpr(Col != std::dynamic_extent){
+            return Col;
+        }
+        else{
+            return columns_;
+        }
+    }
+    constexpr size_t size() const{
+        return rows() * columns();
+    }
+    constexpr bool empty() const{
+        return size() == 0;
+    }
+
+    //Шаг в элементах при переходе к следующей строке (0) или столбцу (1)
+    constexpr size_t stride(size_t dimension) const{
+        if constexpr(std::is_same_v<Layout, layout_right>){
+            return dimension == 0 ? columns() : 1;
+        }
+        else if constexpr(std::is_same_v<Layout, layout_left>){
+            return dimension == 0 ? 1 : rows();
+        }
+        else{
+            return strides_[dimension];
+        }
+    }
+
+    //Элементы занимают непрерывный участок памяти без пропусков
+    constexpr bool is_contiguous() const{
+        if constexpr(std::is_same_v<Layout, layout_stride>){
+            return ((rows() <= 1 || stride(0) == columns()) && (columns() <= 1 || stride(1) == 1))
+                   || ((rows() <= 1 || stride(0) == 1) && (columns() <= 1 || stride(1) == rows()));
+        }
+        else{
+            return true;
+        }
+    }
+
+    constexpr pointer data() const{
+        return data_;
+    }
+
+    //Доступ без проверки индексов
+    constexpr reference operator()(size_t r, size_t c) const{
+        return data_[index(r, c)];
+    }
+    constexpr reference value(size_t r, size_t c) const{
+        if((r >= rows()) || (c >= columns())){
+            throw std::logic_error("matrix_view: index out of range");
+        }
+        return data_[index(r, c)];
+    }
+
+    //Строка как непрерывный участок памяти
+    constexpr std::span<Type, Col> row(size_t r) const requires std::is_same_v<Layout, layout_right>{
+        if(r >= rows()){
+            throw std::logic_error("matrix_view: index out of range");
+        }
+        return std::span<Type, Col>(data_ + r * columns(), columns());
+    }
+
+    //Транспонирование без копирования: меняются местами размеры и шаги
+    constexpr auto transposed() const{
+        if constexpr(std::is_same_v<Layout, layout_right>){
+            return matrix_view<Type, Col, Row, layout_left>(data_, columns(), rows());
+        }
+        else if constexpr(std::is_same_v<Layout, layout_left>){
+            return matrix_view<Type, Col, Row, layout_right>(data_, columns(), rows());
+        }
+        else{
+            return matrix_view<Type, Col, Row, layout_stride>(data_, columns(), rows(), {stride(1), stride(0)});
+        }
+    }
+
+    //Прямоугольная часть rows x columns, начиная с элемента (r, c)
+    constexpr auto submatrix(size_t r, size_t c, size_t rows, size_t columns) const{
+        if((r + rows > this->rows()) || (c + columns > this->columns())){
+            throw std::logic_error("matrix_view: submatrix out of range");
+        }
+        return matrix_view<Type, std::dynamic_extent, std::dynamic_extent, layout_stride>(
+            data_ + ((rows * columns == 0) ? 0 : index(r, c)), rows, columns, {stride(0), stride(1)});
+    }
+
+    //Число элементов буфера от первого до последнего элемента представления
+    constexpr size_t required_span() const{
+        if(empty()){
+            return 0;
+        }
+        return (rows() - 1) * stride(0) + (columns() - 1) * stride(1) + 1;
+    }
+
+private:
+    constexpr size_t index(size_t r, size_t c) const{
+        if constexpr(std::is_same_v<Layout, layout_right>){
+            return r * columns() + c;
+        }
+        else if constexpr(std::is_same_v<Layout, layout_left>){
+            return r + c * rows();
+        }
+        else{
+            return r * strides_[0] + c * strides_[1];
+        }
+    }
+
+    constexpr void check_extents() const{
+        if(((Row != std::dynamic_extent) && (rows_ != Row)) || ((Col != std::dynamic_extent) && (columns_ != Col))){
+            throw std::logic_error("matrix_view: extents mismatch");
+        }
+    }
+
+    pointer data_{};
+    size_t rows_{};
+    size_t columns_{};
+    std::array<size_t, 2> strides_{};   //!Шаги строк и столбцов, используются только layout_stride
+};
+
+template<typename Type>
+matrix_view(Type*, size_t, size_t) -> matrix_view<Type>;
+template<typename Type, size_t Extent>
+matrix_view(std::span<Type, Extent>, size_t, size_t) -> matrix_view<Type>;
+
+}
+
+namespace agl::matrix_algo{
+
+namespace {
+
+//Размеры, известные при компиляции, не противоречат друг другу
+constexpr bool extents_compatible(size_t e1, size_t e2){
+    return (e1 == std::dynamic_extent) || (e2 == std::dynamic_extent) || (e1 == e2);
+}
+
+//Представления имеют общие элементы.
+//Диапазоны адресов представлений с пропусками (чередующиеся каналы одного буфера) могут пересекаться
+//без общих элементов, поэтому в этом случае адреса сравниваются поэлементно.
+//При разных размерах элементов пересечение диапазонов считается пересечением
+template<typename View1, typename View2>
+bool views_overlap(const View1 &v1, const View2 &v2){
+    if(v1.empty() || v2.empty()){
+        return false;
+    }
+    const void *begin1 = v1.data();
+    const void *end1 = v1.data() + v1.required_span();
+    const void *begin2 = v2.data();
+    const void *end2 = v2.data() + v2.required_span();
+    if(!std::less<const void*>{}(begin1, end2) || !std::less<const void*>{}(begin2, end1)){
+        return false;
+    }
+    if((v1.is_contiguous() && v2.is_contiguous()) || (sizeof(*v1.data()) != sizeof(*v2.data()))){
+        return true;
+    }
+    std::vector<const void*> addresses;
+    addresses.reserve(v1.size());
+    for(size_t r = 0; r < v1.rows(); ++r){
+        for(size_t c = 0; c < v1.columns(); ++c){
+            addresses.push_back(&v1(r, c));
+        }
+    }
+    std::ranges::sort(addresses, std::less<const void*>{});
+    for(size_t r = 0; r < v2.rows(); ++r){
+        for(size_t c = 0; c < v2.columns(); ++c){
+            if(std::ranges::binary_search(addresses, static_cast<const void*>(&v2(r, c)), std::less<const void*>{})){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//Строки [first, last) делятся между потоками кусками не короче min_chunk строк
+template<typename Func>
+void parallel_rows(size_t rows, size_t threads, size_t min_chunk, Func func){
+    const auto count = std::clamp<size_t>(rows / std::max<size_t>(min_chunk, 1), 1, std::max<size_t>(threads, 1));
+    if(count == 1){
+        func(size_t{}, rows);
+        return;
+    }
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(count);
+    for(size_t i = 0; i < count; ++i){
+        tasks.push_back(std::async(std::launch::async, func, rows * i / count, rows * (i + 1) / count));
+    }
+    for(auto &task : tasks){
+        task.get();
+    }
+}
+
+}
+
+template<typename Type, size_t R, size_t C, typename Layout>
+constexpr auto transposed(const matrix_view<Type, R, C, Layout> &view){
+    return view.transposed();
+}
+
+//Копирование элементов между представлениями любых раскладок
+template<typename Type1, typename Type2, size_t R1, size_t C1, size_t R2, size_t C2, typename Layout1, typename Layout2>
+    requires (!std::is_const_v<Type2>) && (extents_compatible(R1, R2)) && (extents_compatible(C1, C2))
+constexpr void copy(const matrix_view<Type1, R1, C1, Layout1> &from, const matrix_view<Type2, R2, C2, Layout2> &to){
+    if((from.rows() != to.rows()) || (from.columns() != to.columns())){
+        throw std::logic_error("matrix_view: size mismatch");
+    }
+    if constexpr(std::is_same_v<Layout1, layout_right> && std::is_same_v<Layout2, layout_right>){
+        for(size_t r = 0; r < from.rows(); ++r){
+            std::ranges::copy(from.row(r), to.row(r).begin());
+        }
+    }
+    else{
+        for(size_t r = 0; r < from.rows(); ++r){
+            for(size_t c = 0; c < from.columns(); ++c){
+                to(r, c) = from(r, c);
+            }
+        }
+    }
+}
+
+//out = a * b. Результат пишется в буфер вызывающего, пересечение out с a или b запрещено.
+//Порядок циклов i-k-j: при раскладке по строкам внутренний цикл идёт по соседним элементам b и out.
+//Для b, хранящейся по столбцам, - порядок i-j-k
+template<typename Type1, typename Type2, typename Type3, size_t R1, size_t C1, size_t R2, size_t C2, size_t R3, size_t C3,
+         typename Layout1, typename Layout2, typename Layout3>
+    requires (!std::is_const_v<Type3>) && (extents_compatible(C1, R2)) && (extents_compatible(R1, R3)) && (extents_compatible(C2, C3))
+void mul(const matrix_view<Type1, R1, C1, Layout1> &a, const matrix_view<Type2, R2, C2, Layout2> &b,
+         const matrix_view<Type3, R3, C3, Layout3> &out, size_t threads = 1, size_t min_chunk = 64){
+    if((a.columns() != b.rows()) || (a.rows() != out.rows()) || (b.columns() != out.columns())){
+        throw std::logic_error("matrix_view: size mismatch");
+    }
+    if(views_overlap(a, out) || views_overlap(b, out)){
+        throw std::logic_error("matrix_view: output overlaps input");
+    }
+    if constexpr(std::is_same_v<Layout2, layout_left>){
+        //Столбцы b лежат подряд: скалярное произведение строки a и столбца b
+        parallel_rows(a.rows(), threads, min_chunk, [&a, &b, &out](size_t first, size_t last){
+            for(size_t i = first; i < last; ++i){
+                for(size_t j = 0; j < out.columns(); ++j){
+                    Type3 sum{};
+                    for(size_t k = 0; k < a.columns(); ++k){
+                        sum += a(i, k) * b(k, j);
+                    }
+                    out(i, j) = sum;
+                }
+            }
+        });
+        return;
+    }
+    parallel_rows(a.rows(), threads, min_chunk, [&a, &b, &out](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i){
+            for(size_t j = 0; j < out.columns(); ++j){
+                out(i, j) = Type3{};
+            }
+            for(size_t k = 0; k < a.columns(); ++k){
+                const Type3 aik = a(i, k);
+                for(size_t j = 0; j < out.columns(); ++j){
+                    out(i, j) += aik * b(k, j);
+                }
+            }
+        }
+    });
+}
+
+//y = a * x
+template<typename Type1, typename Type2, typename Type3, size_t R, size_t C, typename Layout>
+    requires (!std::is_const_v<Type3>)
+void mul(const matrix_view<Type1, R, C, Layout> &a, std::span<Type2> x, std::span<Type3> y, size_t threads = 1, size_t min_chunk = 256){
+    if((x.size() != a.columns()) || (y.size() != a.rows())){
+        throw std::logic_error("matrix_view: size mismatch");
+    }
+    parallel_rows(a.rows(), threads, min_chunk, [&a, x, y](size_t first, size_t last){
+        for(size_t i = first; i < last; ++i){
+            Type3 sum{};
+            for(size_t k = 0; k < a.columns(); ++k){
+                sum += a(i, k) * x[k];
+            }
+            y[i] = sum;
+        }
+    });
+}
+
+//Определитель квадратной матрицы. До 4x4 известного при компиляции размера - явные формулы,
+//иначе метод Гаусса с выбором главного элемента по столбцу на рабочей копии
+template<typename Type, size_t R, size_t C, typename Layout>
+    requires std::is_floating_point_v<std::remove_const_t<Type>> && (extents_compatible(R, C))
+auto determinant(const matrix_view<Type, R, C, Layout> &view) -> std::remove_const_t<Type>{
+    using value_type = std::remove_const_t<Type>;
+    if(view.rows() != view.columns()){
+        throw std::logic_error("matrix_view: matrix is not square");
+    }
+    if constexpr((R != std::dynamic_extent) && (R >= 2) && (R <= 4)){
+        std::array<value_type, R * R> temp;
+        copy(view, matrix_view<value_type, R, R>(temp.data()));
+        return determinant(temp);
+    }
+    else{
+        const auto n = view.rows();
+        std::vector<value_type> temp(n * n);
+        copy(view, matrix_view<value_type>(temp.data(), n, n));
+        value_type result = 1;
+        for(size_t i = 0; i < n; ++i){
+            size_t pivot = i;
+            for(size_t r = i + 1; r < n; ++r){
+                if(std::abs(temp[r * n + i]) > std::abs(temp[pivot * n + i])){
+                    pivot = r;
+                }
+            }
+            if(temp[pivot * n + i] == value_type{}){
+                return value_type{};
+            }
+            if(pivot != i){
+                std::swap_ranges(temp.begin() + i * n, temp.begin() + (i + 1) * n, temp.begin() + pivot * n);
+                result = -result;
+            }
+            const auto diagonal = temp[i * n + i];
+            result *= diagonal;
+            for(size_t r = i + 1; r < n; ++r){
+                const auto factor = temp[r * n + i] / diagonal;
+                for(size_t c = i + 1; c < n; ++c){
+                    temp[r * n + c] -= factor * temp[i * n + c];
+                }
+            }
+        }
+        return result;
+    }
+}
+
+}
+
+#endif // MATRIX_VIEW_H
@@ -0,0 +1,169 @@
+#ifndef POINT_CLOUD_IMPL_H
+#define POINT_CLOUD_IMPL_H
+
+#include <span>
+#include <vector>
+
+#include "../system/system_concept.h"
+
+namespace agl {
+
+//Облако точек в раздельном хранении координат (SoA): x и y лежат в отдельных непрерывных массивах
+template<std::floating_point Type>
+struct point_cloud2d_impl final{
+    using type_coordinate = Type;
+
+    point_cloud2d_impl() = default;
+    template<c_point2d_decard Point>
+    point_cloud2d_impl(const std::vector<Point> &points){
+        reserve(points.size());
+        for(const auto &point : points){
+            push_back(point);
+        }
+    }
+
+    size_t size() const{
+        return x_.size();
+    }
+    bool empty() const{
+        return x_.empty();
+    }
+    void reserve(size_t count){
+        x_.reserve(count);
+        y_.reserve(count);
+    }
+    void resize(size_t count){
+        x_.resize(count);
+        y_.resize(count);
+    }
+    void clear(){
+        x_.clear();
+        y_.clear();
+    }
+
+    void push_back(Type x, Type y){
+        x_.push_back(x);
+        y_.push_back(y);
+    }
+    template<c_point2d_decard Point>
+    void push_back(const Point &point){
+        push_back(point.x(), point.y());
+    }
+
+    Type x(size_t index) const{
+        return x_[index];
+    }
+    Type y(size_t index) const{
+        return y_[index];
+    }
+    template<c_point2d_decard Point>
+    Point point(size_t index) const{
+        return Point(x_[index], y_[index]);
+    }
+
+    std::span<Type> xs(){
+        return x_;
+    }
+    std::span<const Type> xs() const{
+        return x_;
+    }
+    std::span<Type> ys(){
+        return y_;
+    }
+    std::span<const Type> ys() const{
+        return y_;
+    }
+
+private:
+    std::vector<Type> x_;
+    std::vector<Type> y_;
+};
+
+//Облако точек пространства в раздельном хранении координат (SoA)
+template<std::floating_point Type>
+struct point_cloud3d_impl final{
+    using type_coordinate = Type;
+
+    point_cloud3d_impl() = default;
+    template<c_point3d_decard Point>
+    point_cloud3d_impl(const std::vector<Point> &points){
+        reserve(points.size());
+        for(const auto &point : points){
+            push_back(point);
+        }
+    }
+
+    size_t size() const{
+        return x_.size();
+    }
+    bool empty() const{
+        return x_.empty();
+    }
+    void reserve(size_t count){
+        x_.reserve(count);
+        y_.reserve(count);
+        h_.reserve(count);
+    }
+    void resize(size_t count){
+        x_.resize(count);
+        y_.resize(count);
+        h_.resize(count);
+    }
+    void clear(){
+        x_.clear();
+        y_.clear();
+        h_.clear();
+    }
+
+    void push_back(Type x, Type y, Type h){
+        x_.push_back(x);
+        y_.push_back(y);
+        h_.push_back(h);
+    }
+    template<c_point3d_decard Point>
+    void push_back(const Point &point){
+        push_back(point.x(), point.y(), point.h());
+    }
+
+    Type x(size_t index) const{
+        return x_[index];
+    }
+    Type y(size_t index) const{
+        return y_[index];
+    }
+    Type h(size_t index) const{
+        return h_[index];
+    }
+    template<c_point3d_decard Point>
+    Point point(size_t index) const{
+        return Point(x_[index], y_[index], h_[index]);
+    }
+
+    std::span<Type> xs(){
+        return x_;
+    }
+    std::span<const Type> xs() const{
+        return x_;
+    }
+    std::span<Type> ys(){
+        return y_;
+    }
+    std::span<const Type> ys() const{
+        return y_;
+    }
+    std::span<Type> hs(){
+        return h_;
+    }
+    std::span<const Type> hs() const{
+        return h_;
+    }
+
+private:
+    std::vector<Type> x_;
+    std::vector<Type> y_;
+    std::vector<Type> h_;
+};
+
+}
+
+#endif // POINT_CLOUD_IMPL_H
@@ -171,6 +171,14 @@ struct point3d_impl final : point3d_abstract<Type, Type, Type>{
     constexpr point3d_impl(auto x, auto y, auto z) : point3d_abstract<Type, Type, Type>(x,y,z){}
 };
 
+template<std::floating_point Type>
+struct point4d_impl final : point4d_abstract<Type, Type, Type, Type>{
+    using type_coordinate = Type;
+
+    constexpr point4d_impl() : point4d_abstract<Type, Type, Type, Type>(){}
+    constexpr point4d_impl(auto x, auto y, auto h, auto time) : point4d_abstract<Type, Type, Type, Type>(x, y, h, time){}
+};
+
 template<std::floating_point Type, c_angle Angle>
 struct polar2d_impl final : polar2d_abstract<Type, Type>{
     using type_coordinate = Type;
@@ -0,0 +1,221 @@
+#ifndef POLYLINE_IMPL_H
+#define POLYLINE_IMPL_H
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "line_impl.h"
+#include "../algorithm/circle_algorithm.h"
+#include "../system/system_concept.h"
+
+namespace agl {
+
+//Ломаная из отрезков и дуг с накопленной длиной: поиск точки по расстоянию за O(log n)
+template<c_point2d_decard Point, c_arc Arc>
+struct polyline_impl final{
+    using type_point = Point;
+    using type_coefficients = Point::type_coordinate;
+
+    struct arc_segment{
+        Arc arc;
+        algorithm::direct direct;
+    };
+    using segment = std::variant<line_section_impl<Point>, arc_segment>;
+
+    polyline_impl() = default;
+    polyline_impl(const std::initializer_list<Point> &list){
+        append(list.begin(), list.end());
+    }
+    polyline_impl(const std::vector<Point> &points){
+        append(points.begin(), points.end());
+    }
+
+    //Добавляет отрезок от последней точки ломаной до заданной точки
+    void append(const Point &point){
+        if(!last_.has_value()){
+            last_ = point;
+            return;
+        }
+        append(line_section_impl<Point>(last_.value(), point));
+    }
+    template<std::input_iterator Iterator>
+    void append(Iterator begin, Iterator end){
+        std::for_each(begin, end, [this](const Point &point){
+            append(point);
+        });
+    }
+    void append(const line_section_impl<Point> &line){
+        push(line, point_algo::distance(line.start(), line.stop()));
+        last_ = line.stop();
+    }
+    void append(const Arc &arc, algorithm::direct direct = algorithm::direct::RIGHT){
+        const arc_segment item{arc, direct};
+        push(item, length_arc(item));
+        last_ = point_at(item, length_arc(item));
+    }
+
+    const std::vector<segment> &segments() const{
+        return segments_;
+    }
+    //Накопленная длина: cumulative()[i] - расстояние от начала ломаной до начала i-го сегмента
+    const std::vector<type_coefficients> &cumulative() const{
+        return cumulative_;
+    }
+    size_t count() const{
+        return segments_.size();
+    }
+    type_coefficients length() const{
+        return cumulative_.empty() ? type_coefficients{} : cumulative_.back();
+    }
+
+    //Возвращает индекс сегмента, содержащего точку на заданном расстоянии от начала
+    std::optional<size_t> segment_index(type_coefficients distance) const{
+        if(segments_.empty() || (distance < 0) || (distance > length() + algorithm::epsilon<type_coefficients>)){
+            return std::nullopt;
+        }
+        const auto item = std::ranges::upper_bound(cumulative_.begin(), std::prev(cumulative_.end()), distance);
+        return std::distance(cumulative_.begin(), item) - 1;
+    }
+
+    //Возвращает координаты точки на заданном расстоянии от начала ломаной
+    std::optional<Point> point_at(type_coefficients distance) const{
+        const auto index = segment_index(distance);
+        if(!index.has_value()){
+            return std::nullopt;
+        }
+        const auto &item = segments_[index.value()];
+        return point_at(item, std::min(distance - cumulative_[index.value()], segment_length(index.value())));
+    }
+
+    //Возвращает расстояние от начала ломаной до проекции точки на ближайший сегмент
+    std::optional<type_coefficients> distance_along(const Point &point) const{
+        if(segments_.empty()){
+            return std::nullopt;
+        }
+        auto best = std::numeric_limits<type_coefficients>::infinity();
+        type_coefficients along{};
+        for(size_t i = 0; i < segments_.size(); ++i){
+            const auto local = project(segments_[i], point, segment_length(i));
+            const auto dist = point_algo::distance(point_at(segments_[i], local), point);
+            if(dist < best){
+                best = dist;
+                along = cumulative_[i] + local;
+            }
+        }
+        return along;
+    }
+
+    //Возвращает расстояние до проекции точки на заданный сегмент
+    std::optional<type_coefficients> distance_along(const Point &point, size_t index) const{
+        if(index >= segments_.size()){
+            return std::nullopt;
+        }
+        return cumulative_[index] + project(segments_[index], point, segment_length(index));
+    }
+
+    //Возвращает точки ломаной с заданным шагом от начала
+    std::vector<Point> resample(type_coefficients interval) const{
+        if(segments_.empty() || !(interval > 0)){
+            return {};
+        }
+        const auto count = static_cast<size_t>(std::floor(length() / interval + algorithm::epsilon<type_coefficients>)) + 1;
+        std::vector<Point> points;
+        points.reserve(count);
+        size_t index{};
+        for(size_t i = 0; i < count; ++i){
+            const auto distance = std::min(i * interval, length());
+            while((index + 1 < segments_.size()) && (cumulative_[index + 1] <= distance)){
+                ++index;
+            }
+            points.push_back(point_at(segments_[index], std::min(distance - cumulative_[index], segment_length(index))));
+        }
+        return points;
+    }
+
+private:
+    void push(const segment &item, type_coefficients length){
+        if(cumulative_.empty()){
+            cumulative_.push_back(type_coefficients{});
+        }
+        segments_.push_back(item);
+        cumulative_.push_back(cumulative_.back() + length);
+    }
+
+    type_coefficients segment_length(size_t index) const{
+        return cumulative_[index + 1] - cumulative_[index];
+    }
+
+    static type_coefficients sweep(const arc_segment &item){
+        const auto begin = (item.direct == algorithm::direct::RIGHT) ? item.arc.start() : item.arc.stop();
+        const auto end = (item.direct == algorithm::direct::RIGHT) ? item.arc.stop() : item.arc.start();
+        return (begin > end) ? end - begin + algorithm::pi_in_2<type_coefficients> : end - begin;
+    }
+
+    static type_coefficients length_arc(const arc_segment &item){
+        return sweep(item) * item.arc.radius();
+    }
+
+    static Point point_at(const segment &item, type_coefficients distance){
+        return std::visit(overloaded_segment{
+            [distance](const line_section_impl<Point> &line){
+                const auto length = point_algo::distance(line.start(), line.stop());
+                if(algorithm::compare(length, 0.)){
+                    return line.start();
+                }
+                const auto k = distance / length;
+                return Point(line.start().x() + k * (line.stop().x() - line.start().x()),
+                             line.start().y() + k * (line.stop().y() - line.start().y()));
+            },
+            [distance](const arc_segment &arc){
+                const auto angle = (arc.direct == algorithm::direct::RIGHT) ? arc.arc.start() + distance / arc.arc.radius()
+                                                                            : arc.arc.start() - distance / arc.arc.radius();
+                return point_algo::new_point(arc.arc.center(), angle, arc.arc.radius());
+            }
+        }, item);
+    }
+
+    static type_coefficients project(const segment &item, const Point &point, type_coefficients length){
+        return std::visit(overloaded_segment{
+            [&point, length](const line_section_impl<Point> &line){
+                if(algorithm::compare(length, 0.)){
+                    return type_coefficients{};
+                }
+                const auto dx = line.stop().x() - line.start().x();
+                const auto dy = line.stop().y() - line.start().y();
+                const auto t = ((point.x() - line.start().x()) * dx + (point.y() - line.start().y()) * dy) / length;
+                return std::clamp(t, type_coefficients{}, length);
+            },
+            [&point, length](const arc_segment &arc){
+                auto delta = point_algo::angle(arc.arc.center(), point) - arc.arc.start();
+                if(arc.direct == algorithm::direct::LEFT){
+                    delta = -delta;
+                }
+                delta = std::fmod(delta, algorithm::pi_in_2<type_coefficients>);
+                if(delta < 0){
+                    delta += algorithm::pi_in_2<type_coefficients>;
+                }
+                const auto along = delta * arc.arc.radius();
+                if(along <= length){
+                    return along;
+                }
+                //Проекция вне дуги: выбираем ближайший конец
+                const auto full = algorithm::pi_in_2<type_coefficients> * arc.arc.radius();
+                return (along - length < full - along) ? length : type_coefficients{};
+            }
+        }, item);
+    }
+
+    template<class... Ts>
+    struct overloaded_segment : Ts... { using Ts::operator()...; };
+
+    std::vector<segment> segments_;
+    std::vector<type_coefficients> cumulative_;
+    std::optional<Point> last_;
+};
+
+}
+
+#endif // POLYLINE_IMPL_H
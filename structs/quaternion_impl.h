@@ -0,0 +1,294 @@
+#ifndef QUATERNION_IMPL_H
+#define QUATERNION_IMPL_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "matrix.h"
+#include "point_cloud_impl.h"
+#include "../algorithm/math_algorithm.h"
+#include "../system/system_concept.h"
+
+namespace agl {
+
+//Углы ориентации (радианы) в соглашениях affine_impl: курс - поворот вокруг h по часовой стрелке,
+//тангаж - поворот вокруг x (положительный поднимает ось y), крен - поворот вокруг y (положительный поднимает ось x).
+//Поворот из связанной системы: R = R_h(heading) * R_x(pitch) * R_y(roll)
+template<std::floating_point Type>
+struct euler_angles{
+    Type heading;
+    Type pitch;
+    Type roll;
+};
+
+//Кватернион w + xi + yj + zk. Единичный кватернион задаёт поворот пространства (x - восток, y - север, h - вверх),
+//q и -q задают один и тот же поворот
+template<std::floating_point Type>
+class quaternion_impl{
+public:
+    using type = Type;
+
+    constexpr quaternion_impl() : w_(1), x_(), y_(), z_(){}
+    constexpr quaternion_impl(Type w, Type x, Type y, Type z) : w_(w), x_(x), y_(y), z_(z){}
+
+    //Поворот на angle вокруг оси axis по правилу правой руки (против часовой стрелки, если смотреть с конца оси)
+    template<c_point3d_decard Point>
+    static constexpr quaternion_impl axis_angle(const Point &axis, Type angle){
+        const Type ax = axis.x();
+        const Type ay = axis.y();
+        const Type ah = axis.h();
+        const auto length = std::sqrt(ax * ax + ay * ay + ah * ah);
+        if(algorithm::compare(length, Type{})){
+            throw std::logic_error("quaternion_impl: zero rotation axis");
+        }
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle / 2);
+        return quaternion_impl(c, s * ax / length, s * ay / length, s * ah / length);
+    }
+
+    //Элементарные повороты, совпадающие с affine_impl::rotation_h, rotation_x, rotation_y
+    static constexpr quaternion_impl heading(Type angle){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle / 2);
+        return quaternion_impl(c, 0, 0, -s);
+    }
+    static constexpr quaternion_impl pitch(Type angle){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle / 2);
+        return quaternion_impl(c, s, 0, 0);
+    }
+    static constexpr quaternion_impl roll(Type angle){
+        const auto [s, c] = algorithm::sincos<algorithm::function_angle<Type>>(angle / 2);
+        return quaternion_impl(c, 0, -s, 0);
+    }
+
+    static constexpr quaternion_impl euler(Type heading_angle, Type pitch_angle, Type roll_angle){
+        return heading(heading_angle) * pitch(pitch_angle) * roll(roll_angle);
+    }
+    static constexpr quaternion_impl euler(const euler_angles<Type> &angles){
+        return euler(angles.heading, angles.pitch, angles.roll);
+    }
+
+    //Кватернион матрицы поворота (метод Шеппарда: делится наибольшая из диагональных комбинаций)
+    static constexpr quaternion_impl from_matrix(const matrix<Type, 3, 3> &m){
+        const auto trace = m.value(0, 0) + m.value(1, 1) + m.value(2, 2);
+        quaternion_impl temp;
+        if(trace > 0){
+            const auto s = 2 * std::sqrt(trace + 1);
+            temp = quaternion_impl(s / 4, (m.value(2, 1) - m.value(1, 2)) / s, (m.value(0, 2) - m.value(2, 0)) / s,
+                                   (m.value(1, 0) - m.value(0, 1)) / s);
+        }
+        else if((m.value(0, 0) >= m.value(1, 1)) && (m.value(0, 0) >= m.value(2, 2))){
+            const auto s = 2 * std::sqrt(1 + m.value(0, 0) - m.value(1, 1) - m.value(2, 2));
+            temp = quaternion_impl((m.value(2, 1) - m.value(1, 2)) / s, s / 4, (m.value(0, 1) + m.value(1, 0)) / s,
+                                   (m.value(0, 2) + m.value(2, 0)) / s);
+        }
+        else if(m.value(1, 1) >= m.value(2, 2)){
+            const auto s = 2 * std::sqrt(1 + m.value(1, 1) - m.value(0, 0) - m.value(2, 2));
+            temp = quaternion_impl((m.value(0, 2) - m.value(2, 0)) / s, (m.value(0, 1) + m.value(1, 0)) / s, s / 4,
+                                   (m.value(1, 2) + m.value(2, 1)) / s);
+        }
+        else{
+            const auto s = 2 * std::sqrt(1 + m.value(2, 2) - m.value(0, 0) - m.value(1, 1));
+            temp = quaternion_impl((m.value(1, 0) - m.value(0, 1)) / s, (m.value(0, 2) + m.value(2, 0)) / s,
+                                   (m.value(1, 2) + m.value(2, 1)) / s, s / 4);
+        }
+        return temp.normalized();
+    }
+
+    constexpr Type w() const{
+        return w_;
+    }
+    constexpr Type x() const{
+        return x_;
+    }
+    constexpr Type y() const{
+        return y_;
+    }
+    constexpr Type z() const{
+        return z_;
+    }
+
+    constexpr Type norm() const{
+        return std::sqrt(dot(*this, *this));
+    }
+    constexpr quaternion_impl normalized() const{
+        const auto n = norm();
+        if(algorithm::compare(n, Type{})){
+            throw std::logic_error("quaternion_impl: zero quaternion");
+        }
+        return quaternion_impl(w_ / n, x_ / n, y_ / n, z_ / n);
+    }
+    constexpr quaternion_impl conjugate() const{
+        return quaternion_impl(w_, -x_, -y_, -z_);
+    }
+    constexpr quaternion_impl inverse() const{
+        const auto n = dot(*this, *this);
+        if(algorithm::compare(n, Type{})){
+            throw std::logic_error("quaternion_impl: zero quaternion");
+        }
+        return quaternion_impl(w_ / n, -x_ / n, -y_ / n, -z_ / n);
+    }
+
+    //Угол поворота [0, pi] и его ось (для нулевого поворота - ось h)
+    Type angle() const{
+        const auto v = std::sqrt(x_ * x_ + y_ * y_ + z_ * z_);
+        return 2 * std::atan2(v, std::abs(w_));
+    }
+    template<c_point3d_decard Point>
+    Point axis() const{
+        const auto v = std::sqrt(x_ * x_ + y_ * y_ + z_ * z_);
+        if(algorithm::compare(v, Type{})){
+            return Point(0, 0, 1);
+        }
+        const auto sign = (w_ < 0) ? Type(-1) : Type(1);
+        return Point(sign * x_ / v, sign * y_ / v, sign * z_ / v);
+    }
+
+    //Матрица поворота единичного кватерниона
+    constexpr matrix<Type, 3, 3> to_matrix() const{
+        const auto k = coefficients();
+        return matrix<Type, 3, 3>{k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7], k[8]};
+    }
+
+    constexpr euler_angles<Type> to_euler() const{
+        const auto k = coefficients();
+        const auto pitch_angle = std::asin(std::clamp(k[7], Type(-1), Type(1)));
+        //Вырожденный случай (тангаж +-90 градусов): курс и крен неразличимы, крен принимается нулевым
+        if(algorithm::compare(std::abs(k[7]), Type(1))){
+            return {std::atan2(-k[3], k[0]), pitch_angle, Type{}};
+        }
+        return {std::atan2(k[1], k[4]), pitch_angle, std::atan2(k[6], k[8])};
+    }
+
+    //Композиция: сначала q2, затем q1 (произведение Гамильтона)
+    constexpr friend quaternion_impl operator*(const quaternion_impl &q1, const quaternion_impl &q2){
+        return quaternion_impl(q1.w_ * q2.w_ - q1.x_ * q2.x_ - q1.y_ * q2.y_ - q1.z_ * q2.z_,
+                               q1.w_ * q2.x_ + q1.x_ * q2.w_ + q1.y_ * q2.z_ - q1.z_ * q2.y_,
+                               q1.w_ * q2.y_ - q1.x_ * q2.z_ + q1.y_ * q2.w_ + q1.z_ * q2.x_,
+                               q1.w_ * q2.z_ + q1.x_ * q2.y_ - q1.y_ * q2.x_ + q1.z_ * q2.w_);
+    }
+    constexpr quaternion_impl then(const quaternion_impl &next) const{
+        return next * *this;
+    }
+
+    constexpr friend Type dot(const quaternion_impl &q1, const quaternion_impl &q2){
+        return q1.w_ * q2.w_ + q1.x_ * q2.x_ + q1.y_ * q2.y_ + q1.z_ * q2.z_;
+    }
+
+    //Покомпонентное сравнение (q и -q не равны, хотя задают один поворот)
+    constexpr friend bool operator==(const quaternion_impl &q1, const quaternion_impl &q2){
+        return algorithm::compare(q1.w_, q2.w_) && algorithm::compare(q1.x_, q2.x_)
+               && algorithm::compare(q1.y_, q2.y_) && algorithm::compare(q1.z_, q2.z_);
+    }
+
+    //Поворот точки: v' = v + w * t + u x t, t = 2 * (u x v)
+    template<c_point3d_decard Point>
+    constexpr Point apply(const Point &point) const{
+        const Type px = point.x();
+        const Type py = point.y();
+        const Type ph = point.h();
+        const auto tx = 2 * (y_ * ph - z_ * py);
+        const auto ty = 2 * (z_ * px - x_ * ph);
+        const auto th = 2 * (x_ * py - y_ * px);
+        return Point(px + w_ * tx + y_ * th - z_ * ty, py + w_ * ty + z_ * tx - x_ * th, ph + w_ * th + x_ * ty - y_ * tx);
+    }
+
+    //Пакетный поворот: кватернион один раз переводится в матрицу (9 умножений на точку вместо 18)
+    template<c_point3d_decard Point>
+    void apply(std::span<Point> points) const{
+        const auto k = coefficients();
+        for(auto &point : points){
+            const Type px = point.x();
+            const Type py = point.y();
+            const Type ph = point.h();
+            point = Point(k[0] * px + k[1] * py + k[2] * ph, k[3] * px + k[4] * py + k[5] * ph,
+                          k[6] * px + k[7] * py + k[8] * ph);
+        }
+    }
+    template<c_point3d_decard Point>
+    std::vector<Point> apply(const std::vector<Point> &points) const{
+        auto temp = points;
+        apply(std::span<Point>(temp));
+        return temp;
+    }
+
+    //Раздельные массивы координат: цикл без ветвлений векторизуется
+    void apply(std::span<Type> xs, std::span<Type> ys, std::span<Type> hs) const{
+        if((xs.size() != ys.size()) || (xs.size() != hs.size())){
+            throw std::logic_error("quaternion_impl: size mismatch");
+        }
+        const auto k = coefficients();
+        for(size_t i = 0; i < xs.size(); ++i){
+            const auto px = xs[i];
+            const auto py = ys[i];
+            const auto ph = hs[i];
+            xs[i] = k[0] * px + k[1] * py + k[2] * ph;
+            ys[i] = k[3] * px + k[4] * py + k[5] * ph;
+            hs[i] = k[6] * px + k[7] * py + k[8] * ph;
+        }
+    }
+    void apply(point_cloud3d_impl<Type> &cloud) const{
+        apply(cloud.xs(), cloud.ys(), cloud.hs());
+    }
+
+private:
+    //Матрица поворота по строкам
+    constexpr std::array<Type, 9> coefficients() const{
+        const auto xx = x_ * x_;
+        const auto yy = y_ * y_;
+        const auto zz = z_ * z_;
+        const auto xy = x_ * y_;
+        const auto xz = x_ * z_;
+        const auto yz = y_ * z_;
+        const auto wx = w_ * x_;
+        const auto wy = w_ * y_;
+        const auto wz = w_ * z_;
+        return {1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy),
+                2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx),
+                2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy)};
+    }
+
+    Type w_;
+    Type x_;
+    Type y_;
+    Type z_;
+};
+
+namespace quaternion_algo{
+
+//Сферическая линейная интерполяция по кратчайшей дуге, t in [0, 1]
+template<std::floating_point Type>
+quaternion_impl<Type> slerp(const quaternion_impl<Type> &q1, const quaternion_impl<Type> &q2, Type t){
+    auto cos_angle = dot(q1, q2);
+    auto sign = Type(1);
+    if(cos_angle < 0){
+        cos_angle = -cos_angle;
+        sign = Type(-1);
+    }
+    Type k1 = 1 - t;
+    Type k2 = t;
+    //Для близких кватернионов sin(angle) мал, достаточно нормированной линейной интерполяции
+    if(cos_angle < Type(0.9995)){
+        const auto angle = std::acos(cos_angle);
+        const auto s = std::sin(angle);
+        k1 = std::sin((1 - t) * angle) / s;
+        k2 = std::sin(t * angle) / s;
+    }
+    k2 *= sign;
+    return quaternion_impl<Type>(k1 * q1.w() + k2 * q2.w(), k1 * q1.x() + k2 * q2.x(),
+                                 k1 * q1.y() + k2 * q2.y(), k1 * q1.z() + k2 * q2.z()).normalized();
+}
+
+//Угол между поворотами [0, pi]
+template<std::floating_point Type>
+Type angle(const quaternion_impl<Type> &q1, const quaternion_impl<Type> &q2){
+    return (q1.conjugate() * q2).angle();
+}
+
+}
+
+}
+
+#endif // QUATERNION_IMPL_H
@@ -0,0 +1,475 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <future>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "matrix.h"
+#include "vector.h"
+
+namespace agl {
+
+//Ненулевой элемент для построения разреженной матрицы
+template<std::floating_point Type>
+struct sparse_entry{
+    size_t row;
+    size_t column;
+    Type value;
+};
+
+//Разреженная матрица в формате CSR (сжатые строки): для строки i элементы лежат в
+//[offsets[i], offsets[i + 1]) массивов columns/values, столбцы внутри строки упорядочены.
+//Формат CSC матрицы A совпадает с CSR матрицы A^T (transposed)
+template<std::floating_point Type>
+class sparse_matrix{
+public:
+    using type = Type;
+
+    sparse_matrix() : offsets_(1){}
+    //Из списка элементов: повторы (row, column) суммируются
+    sparse_matrix(size_t rows, size_t columns, const std::vector<sparse_entry<Type>> &entries)
+        : rows_(rows), columns_(columns), offsets_(rows + 1){
+        //Распределение подсчётом по строкам, затем сортировка внутри строк
+        for(const auto &entry : entries){
+            if((entry.row >= rows) || (entry.column >= columns)){
+                throw std::logic_error(std::format("Index error sparse_matrix: row = {}, column = {}", entry.row, entry.column));
+            }
+            ++offsets_[entry.row + 1];
+        }
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+        std::vector<std::pair<size_t, Type>> items(entries.size());
+        auto position = offsets_;
+        for(const auto &entry : entries){
+            items[position[entry.row]++] = {entry.column, entry.value};
+        }
+        columns_index_.reserve(items.size());
+        values_.reserve(items.size());
+        size_t first = 0;
+        for(size_t i = 0; i < rows; ++i){
+            const auto begin = items.begin() + offsets_[i];
+            const auto end = items.begin() + offsets_[i + 1];
+            std::sort(begin, end, [](const auto &a, const auto &b){
+                return a.first < b.first;
+            });
+            for(auto it = begin; it != end; ++it){
+                if((columns_index_.size() > first) && (columns_index_.back() == it->first)){
+                    values_.back() += it->second;
+                }
+                else{
+                    columns_index_.push_back(it->first);
+                    values_.push_back(it->second);
+                }
+            }
+            offsets_[i] = first;
+            first = columns_index_.size();
+        }
+        offsets_[rows] = first;
+    }
+    //Из плотной матрицы (нули не хранятся)
+    template<size_t R, size_t C>
+    explicit sparse_matrix(const matrix<Type, R, C> &m) : rows_(R), columns_(C), offsets_(R + 1){
+        for(size_t i = 0; i < R; ++i){
+            for(size_t j = 0; j < C; ++j){
+                if(m.value(i, j) != Type{}){
+                    columns_index_.push_back(j);
+                    values_.push_back(m.value(i, j));
+                }
+            }
+            offsets_[i + 1] = values_.size();
+        }
+    }
+
+    size_t rows() const{
+        return rows_;
+    }
+    size_t columns() const{
+        return columns_;
+    }
+    size_t non_zeros() const{
+        return values_.size();
+    }
+
+    //Массивы CSR
+    std::span<const size_t> offsets() const{
+        return offsets_;
+    }
+    std::span<const size_t> column_indices() const{
+        return columns_index_;
+    }
+    std::span<const Type> values() const{
+        return values_;
+    }
+    std::span<Type> values(){
+        return values_;
+    }
+
+    //Элемент (двоичный поиск в строке), отсутствующий элемент - ноль
+    Type value(size_t row, size_t column) const{
+        if((row >= rows_) || (column >= columns_)){
+            throw std::logic_error(std::format("Index error sparse_matrix: row = {}, column = {}", row, column));
+        }
+        const auto begin = columns_index_.begin() + offsets_[row];
+        const auto end = columns_index_.begin() + offsets_[row + 1];
+        const auto it = std::lower_bound(begin, end, column);
+        return ((it != end) && (*it == column)) ? values_[it - columns_index_.begin()] : Type{};
+    }
+
+    template<size_t R, size_t C>
+    matrix<Type, R, C> to_dense() const{
+        if((R != rows_) || (C != columns_)){
+            throw std::logic_error("sparse_matrix: size mismatch");
+        }
+        matrix<Type, R, C> temp;
+        for(size_t i = 0; i < R; ++i){
+            for(size_t k = offsets_[i]; k < offsets_[i + 1]; ++k){
+                temp.value(i, columns_index_[k]) = values_[k];
+            }
+        }
+        return temp;
+    }
+
+    sparse_matrix transposed() const{
+        sparse_matrix temp;
+        temp.rows_ = columns_;
+        temp.columns_ = rows_;
+        temp.offsets_.assign(columns_ + 1, 0);
+        for(const auto column : columns_index_){
+            ++temp.offsets_[column + 1];
+        }
+        std::partial_sum(temp.offsets_.begin(), temp.offsets_.end(), temp.offsets_.begin());
+        temp.columns_index_.resize(values_.size());
+        temp.values_.resize(values_.size());
+        auto position = temp.offsets_;
+        //Строки обходятся по возрастанию, поэтому столбцы в строках результата упорядочены
+        for(size_t i = 0; i < rows_; ++i){
+            for(size_t k = offsets_[i]; k < offsets_[i + 1]; ++k){
+                const auto index = position[columns_index_[k]]++;
+                temp.columns_index_[index] = i;
+                temp.values_[index] = values_[k];
+            }
+        }
+        return temp;
+    }
+
+    std::vector<Type> diagonal() const{
+        std::vector<Type> temp(std::min(rows_, columns_));
+        for(size_t i = 0; i < temp.size(); ++i){
+            temp[i] = value(i, i);
+        }
+        return temp;
+    }
+
+    //y = A * x. Строки делятся между потоками кусками не короче min_chunk строк, запись в y не пересекается
+    void multiply(std::span<const Type> x, std::span<Type> y, size_t threads = 1, size_t min_chunk = 16384) const{
+        if((x.size() != columns_) || (y.size() != rows_)){
+            throw std::logic_error("sparse_matrix: size mismatch");
+        }
+        const auto count = std::clamp<size_t>(rows_ / std::max<size_t>(min_chunk, 1), 1, std::max<size_t>(threads, 1));
+        if(count == 1){
+            multiply_rows(x, y, 0, rows_);
+            return;
+        }
+        //Куски выравниваются по числу ненулевых элементов, а не строк
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(count);
+        size_t first = 0;
+        for(size_t i = 0; i < count; ++i){
+            const auto target = non_zeros() * (i + 1) / count;
+            const auto last = (i + 1 == count) ? rows_
+                                               : static_cast<size_t>(std::lower_bound(offsets_.begin() + first, offsets_.end() - 1, target)
+                                                                     - offsets_.begin());
+            tasks.push_back(std::async(std::launch::async, [this, x, y, first, last](){
+                multiply_rows(x, y, first, last);
+            }));
+            first = last;
+        }
+        for(auto &task : tasks){
+            task.get();
+        }
+    }
+    std::vector<Type> multiply(const std::vector<Type> &x, size_t threads = 1) const{
+        std::vector<Type> temp(rows_);
+        multiply(x, std::span(temp), threads);
+        return temp;
+    }
+
+    //y = A^T * x без построения транспонированной матрицы (последовательно, запись в y разбросана)
+    void multiply_transposed(std::span<const Type> x, std::span<Type> y) const{
+        if((x.size() != rows_) || (y.size() != columns_)){
+            throw std::logic_error("sparse_matrix: size mismatch");
+        }
+        std::ranges::fill(y, Type{});
+        for(size_t i = 0; i < rows_; ++i){
+            const auto xi = x[i];
+            for(size_t k = offsets_[i]; k < offsets_[i + 1]; ++k){
+                y[columns_index_[k]] += values_[k] * xi;
+            }
+        }
+    }
+
+    //Произведение на плотную матрицу x (columns x count, по строкам): y (rows x count, по строкам)
+    void multiply(std::span<const Type> x, size_t count, std::span<Type> y) const{
+        if((x.size() != columns_ * count) || (y.size() != rows_ * count)){
+            throw std::logic_error("sparse_matrix: size mismatch");
+        }
+        std::ranges::fill(y, Type{});
+        for(size_t i = 0; i < rows_; ++i){
+            auto *out = y.data() + i * count;
+            for(size_t k = offsets_[i]; k < offsets_[i + 1]; ++k){
+                const auto *in = x.data() + columns_index_[k] * count;
+                const auto a = values_[k];
+                for(size_t j = 0; j < count; ++j){
+                    out[j] += a * in[j];
+                }
+            }
+        }
+    }
+
+    template<size_t C, size_t K>
+    friend auto operator*(const sparse_matrix &m, const matrix<Type, C, K> &x){
+        return m.template multiply_dense<C, K>(x);
+    }
+    template<size_t N>
+    friend std::vector<Type> operator*(const sparse_matrix &m, const vector<Type, N> &x){
+        std::vector<Type> temp(m.rows_);
+        m.multiply(std::span<const Type>(x.begin(), x.end()), std::span(temp));
+        return temp;
+    }
+    friend std::vector<Type> operator*(const sparse_matrix &m, const std::vector<Type> &x){
+        return m.multiply(x);
+    }
+
+private:
+    void multiply_rows(std::span<const Type> x, std::span<Type> y, size_t first, size_t last) const{
+        const auto *column = columns_index_.data();
+        const auto *value = values_.data();
+        for(size_t i = first; i < last; ++i){
+            Type sum{};
+            for(size_t k = offsets_[i]; k < offsets_[i + 1]; ++k){
+                sum += value[k] * x[column[k]];
+            }
+            y[i] = sum;
+        }
+    }
+
+    //Результат - std::vector строк по K элементов, число строк известно только во время выполнения
+    template<size_t C, size_t K>
+    std::vector<Type> multiply_dense(const matrix<Type, C, K> &x) const{
+        std::vector<Type> in(C * K);
+        for(size_t i = 0; i < C; ++i){
+            for(size_t j = 0; j < K; ++j){
+                in[i * K + j] = x.value(i, j);
+            }
+        }
+        std::vector<Type> temp(rows_ * K);
+        multiply(std::span<const Type>(in), K, std::span(temp));
+        return temp;
+    }
+
+    size_t rows_{};
+    size_t columns_{};
+    std::vector<size_t> offsets_;
+    std::vector<size_t> columns_index_;
+    std::vector<Type> values_;
+};
+
+//Итог итерационного решения
+template<std::floating_point Type>
+struct iterative_result{
+    size_t iterations;
+    Type residual;      //!Норма невязки (для lsqr - оценка нормы r = b - A x)
+    bool converged;
+};
+
+namespace matrix_algo{
+
+namespace {
+
+template<std::floating_point Type>
+Type dot(std::span<const Type> a, std::span<const Type> b){
+    return std::inner_product(a.begin(), a.end(), b.begin(), Type{});
+}
+
+template<std::floating_point Type>
+Type norm(std::span<const Type> a){
+    return std::sqrt(dot(a, a));
+}
+
+}
+
+//Метод сопряжённых градиентов с диагональным (якобиевым) предобусловливанием для симметричной
+//положительно определённой матрицы. x - начальное приближение и результат. Останов по ||b - A x|| <= tolerance * ||b||
+template<std::floating_point Type>
+iterative_result<Type> conjugate_gradient(const sparse_matrix<Type> &a, std::span<const Type> b, std::span<Type> x,
+                                          Type tolerance = 1e-10, size_t max_iterations = 0, size_t threads = 1){
+    const auto n = a.rows();
+    if((a.columns() != n) || (b.size() != n) || (x.size() != n)){
+        throw std::logic_error("conjugate_gradient: size mismatch");
+    }
+    if(max_iterations == 0){
+        max_iterations = 2 * n;
+    }
+    auto inverse_diagonal = a.diagonal();
+    for(auto &value : inverse_diagonal){
+        value = (value > Type{}) ? 1 / value : Type(1);
+    }
+    std::vector<Type> r(n);
+    std::vector<Type> z(n);
+    std::vector<Type> p(n);
+    std::vector<Type> q(n);
+    a.multiply(std::span<const Type>(x), std::span(r), threads);
+    for(size_t i = 0; i < n; ++i){
+        r[i] = b[i] - r[i];
+        z[i] = inverse_diagonal[i] * r[i];
+    }
+    p = z;
+    const auto b_norm = norm(b);
+    const auto target = tolerance * ((b_norm > Type{}) ? b_norm : Type(1));
+    auto rz = dot<Type>(r, z);
+    auto residual = norm<Type>(r);
+    size_t iteration = 0;
+    for(; (iteration < max_iterations) && (residual > target); ++iteration){
+        a.multiply(std::span<const Type>(p), std::span(q), threads);
+        const auto pq = dot<Type>(p, q);
+        if(pq <= Type{}){
+            throw std::logic_error("conjugate_gradient: matrix is not positive definite");
+        }
+        const auto alpha = rz / pq;
+        for(size_t i = 0; i < n; ++i){
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            z[i] = inverse_diagonal[i] * r[i];
+        }
+        const auto rz_new = dot<Type>(r, z);
+        const auto beta = rz_new / rz;
+        rz = rz_new;
+        for(size_t i = 0; i < n; ++i){
+            p[i] = z[i] + beta * p[i];
+        }
+        residual = norm<Type>(r);
+    }
+    return {iteration, residual, residual <= target};
+}
+
+template<std::floating_point Type>
+std::vector<Type> conjugate_gradient(const sparse_matrix<Type> &a, const std::vector<Type> &b, Type tolerance = 1e-10){
+    std::vector<Type> x(a.columns());
+    conjugate_gradient(a, std::span<const Type>(b), std::span(x), tolerance);
+    return x;
+}
+
+//LSQR (Пейдж, Сондерс): min ||A x - b||^2 + damp^2 ||x||^2 для прямоугольной матрицы без построения A^T A.
+//На итерации одно умножение на A и одно на A^T. Останов: совместная система ||r|| <= tolerance * ||b||
+//или задача МНК ||A^T r|| <= tolerance * ||A|| * ||r||. x - начальное приближение и результат
+template<std::floating_point Type>
+iterative_result<Type> lsqr(const sparse_matrix<Type> &a, std::span<const Type> b, std::span<Type> x,
+                            Type tolerance = 1e-10, size_t max_iterations = 0, Type damp = 0, size_t threads = 1){
+    const auto m = a.rows();
+    const auto n = a.columns();
+    if((b.size() != m) || (x.size() != n)){
+        throw std::logic_error("lsqr: size mismatch");
+    }
+    if(max_iterations == 0){
+        max_iterations = 4 * n;
+    }
+    auto scale = [](std::span<Type> v, Type k){
+        for(auto &value : v){
+            value *= k;
+        }
+    };
+    //Решается задача для поправки к начальному приближению: u = b - A x
+    std::vector<Type> u(m);
+    std::vector<Type> v(n);
+    std::vector<Type> w(n);
+    std::vector<Type> dx(n);
+    std::vector<Type> temp_m(m);
+    std::vector<Type> temp_n(n);
+    a.multiply(std::span<const Type>(x), std::span(u), threads);
+    for(size_t i = 0; i < m; ++i){
+        u[i] = b[i] - u[i];
+    }
+    auto beta = norm<Type>(u);
+    const auto b_norm = norm(b);
+    if(beta == Type{}){
+        return {0, Type{}, true};
+    }
+    scale(u, 1 / beta);
+    a.multiply_transposed(u, v);
+    auto alpha = norm<Type>(v);
+    if(alpha == Type{}){
+        return {0, beta, true};
+    }
+    scale(v, 1 / alpha);
+    w = v;
+    auto phi_bar = beta;
+    auto rho_bar = alpha;
+    auto a_norm2 = Type{};
+    size_t iteration = 0;
+    bool converged = false;
+    while(iteration < max_iterations){
+        ++iteration;
+        //Бидиагонализация Голуба-Кахана
+        a.multiply(std::span<const Type>(v), std::span(temp_m), threads);
+        for(size_t i = 0; i < m; ++i){
+            u[i] = temp_m[i] - alpha * u[i];
+        }
+        beta = norm<Type>(u);
+        if(beta > Type{}){
+            scale(u, 1 / beta);
+        }
+        a_norm2 += alpha * alpha + beta * beta + damp * damp;
+        a.multiply_transposed(u, temp_n);
+        for(size_t i = 0; i < n; ++i){
+            v[i] = temp_n[i] - beta * v[i];
+        }
+        alpha = norm<Type>(v);
+        if(alpha > Type{}){
+            scale(v, 1 / alpha);
+        }
+        //Вращения: сначала исключается damp, затем beta. rho_bar1 сохраняет знак rho_bar, тогда phi_bar >= 0
+        const auto rho_bar1 = std::copysign(std::sqrt(rho_bar * rho_bar + damp * damp), rho_bar);
+        const auto c1 = rho_bar / rho_bar1;
+        phi_bar = c1 * phi_bar;
+        const auto rho = std::sqrt(rho_bar1 * rho_bar1 + beta * beta);
+        const auto c = rho_bar1 / rho;
+        const auto s = beta / rho;
+        const auto theta = s * alpha;
+        rho_bar = -c * alpha;
+        const auto phi = c * phi_bar;
+        phi_bar = s * phi_bar;
+        for(size_t i = 0; i < n; ++i){
+            dx[i] += (phi / rho) * w[i];
+            w[i] = v[i] - (theta / rho) * w[i];
+        }
+        const auto residual = phi_bar;
+        const auto normal_residual = phi_bar * alpha * std::abs(c);
+        if((residual <= tolerance * b_norm) || (normal_residual <= tolerance * std::sqrt(a_norm2) * residual)){
+            converged = true;
+            break;
+        }
+    }
+    for(size_t i = 0; i < n; ++i){
+        x[i] += dx[i];
+    }
+    return {iteration, phi_bar, converged};
+}
+
+template<std::floating_point Type>
+std::vector<Type> lsqr(const sparse_matrix<Type> &a, const std::vector<Type> &b, Type tolerance = 1e-10){
+    std::vector<Type> x(a.columns());
+    lsqr(a, std::span<const Type>(b), std::span(x), tolerance);
+    return x;
+}
+
+}
+
+}
+
+#endif // SPARSE_MATRIX_H
@@ -4,6 +4,8 @@
 #include "../system/system_concept.h"
 #include "../system/system_function.h"
 #include "../algorithm/math_algorithm.h"
+#include "ellipsoid_impl.h"
+#include <cmath>
 
 namespace agl {
 
@@ -115,6 +117,68 @@ struct point_geo2d_impl final : point_geo2d_abstract<Type, Type>{
     }
 };
 
+//Географическая точка с заранее вычисленными sin/cos широты и приведённой широтой эллипсоида Ellipsoid.
+//Геодезические алгоритмы берут эти значения вместо пересчёта. Точка неизменяема: кэш строится в конструкторе
+template<std::floating_point Type, c_angle Angle, c_ellipsoid Ellipsoid = pz90<Type>>
+struct point_geo2d_prepared final{
+    using type_coordinate = Type;
+    using ellipsoid = Ellipsoid;
+
+    constexpr point_geo2d_prepared() : point_geo2d_prepared(Type(), Type()){}
+    constexpr point_geo2d_prepared(Type latitude, Type longitude)
+        : latitude_(latitude), longitude_(longitude), sin_latitude_(std::sin(latitude)), cos_latitude_(std::cos(latitude)){
+        const auto os = std::sqrt(1 - Ellipsoid::eccentricity2_1 * sin_latitude_ * sin_latitude_);
+        sin_u_ = sin_latitude_ * Ellipsoid::axis_ratio / os;
+        cos_u_ = cos_latitude_ / os;
+    }
+    constexpr point_geo2d_prepared(const Angle &latitude, const Angle &longitude)
+        : point_geo2d_prepared(static_cast<Type>(latitude.radian()), static_cast<Type>(longitude.radian())){}
+    constexpr point_geo2d_prepared(const point_geo2d_impl<Type, Angle> &point)
+        : point_geo2d_prepared(static_cast<Type>(point.latitude()), static_cast<Type>(point.longitude())){}
+
+    constexpr Type latitude() const{
+        return latitude_;
+    }
+    constexpr Type longitude() const{
+        return longitude_;
+    }
+    constexpr Angle latitude_angle() const{
+        return Angle(latitude_);
+    }
+    constexpr Angle longitude_angle() const{
+        return Angle(longitude_);
+    }
+    constexpr Type sin_latitude() const{
+        return sin_latitude_;
+    }
+    constexpr Type cos_latitude() const{
+        return cos_latitude_;
+    }
+    //!sin и cos приведённой широты
+    constexpr Type sin_u() const{
+        return sin_u_;
+    }
+    constexpr Type cos_u() const{
+        return cos_u_;
+    }
+
+    constexpr point_geo2d_impl<Type, Angle> point() const{
+        return point_geo2d_impl<Type, Angle>(latitude_, longitude_);
+    }
+
+    friend constexpr bool operator==(const point_geo2d_prepared &point1, const point_geo2d_prepared &point2){
+        return algorithm::compare(point1.latitude_, point2.latitude_) && algorithm::compare(point1.longitude_, point2.longitude_);
+    }
+
+private:
+    Type latitude_;
+    Type longitude_;
+    Type sin_latitude_;
+    Type cos_latitude_;
+    Type sin_u_{};
+    Type cos_u_{};
+};
+
 template<std::floating_point Type, c_point2d_geo PointGeo, c_angle Angle>
 struct half_line_geo_impl final {
     using type_point = PointGeo;
@@ -169,6 +233,7 @@ private:
 template<std::floating_point Type, c_point2d_geo PointGeo>
 struct circle_geo_impl final {
     using figure = std::true_type;
+    using type_point = PointGeo;
 
     constexpr circle_geo_impl(const PointGeo &center, Type radius)
         : center_(center), radius_(radius){}
@@ -188,6 +253,7 @@ private:
 template<std::floating_point Type, c_point2d_geo PointGeo, c_angle Angle>
 struct arc_geo_impl final {
     using figure = std::false_type;
+    using type_point = PointGeo;
 
     constexpr arc_geo_impl(const PointGeo &center, Type radius, Type start, Type stop)
         : center_(center), radius_(radius), start_(start), stop_(stop){}
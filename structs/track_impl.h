@@ -0,0 +1,183 @@
+#ifndef TRACK_IMPL_H
+#define TRACK_IMPL_H
+
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+
+#include "../algorithm/point_algorithm.h"
+#include "../system/spsc_ring_buffer.h"
+#include "../system/system_concept.h"
+
+namespace agl {
+
+template<std::floating_point Type>
+struct track_velocity{
+    Type ground_speed;   //!Путевая скорость
+    Type course;         //!Путевой угол (радианы, от оси y по часовой стрелке)
+    Type vertical_speed; //!Вертикальная скорость
+};
+
+//Трек из отметок с временем. Отметки поступают из потока писателя через кольцевой буфер без блокировок (push),
+//поток читателя переносит их в историю (poll) и выполняет запросы. История хранит последние capacity отметок
+template<c_point4d_decard Point>
+class track_impl{
+public:
+    using type_point = Point;
+    using Type = Point::type_coordinate;
+
+    explicit track_impl(size_t capacity = 1024, size_t ingest_capacity = 256)
+        : ingest_(ingest_capacity), history_(std::max<size_t>(capacity, 2)){}
+
+    //Поток писателя. Возвращает false, если буфер приёма переполнен
+    bool push(const Point &point){
+        return ingest_.push(point);
+    }
+
+    //Поток читателя. Переносит принятые отметки в историю, отметки не новее последней отбрасываются
+    size_t poll(){
+        size_t count{};
+        while(auto point = ingest_.pop()){
+            if((size_ > 0) && !(point->time() > back().time())){
+                continue;
+            }
+            history_[(first_ + size_) % history_.size()] = point.value();
+            if(size_ < history_.size()){
+                ++size_;
+            }
+            else{
+                first_ = (first_ + 1) % history_.size();
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    size_t size() const{
+        return size_;
+    }
+    bool empty() const{
+        return size_ == 0;
+    }
+    //Отметка по порядку от самой старой
+    const Point &at(size_t index) const{
+        return history_[(first_ + index) % history_.size()];
+    }
+    const Point &back() const{
+        return at(size_ - 1);
+    }
+
+    //Отметки за последние seconds единиц времени (представление действительно до следующего poll)
+    auto window(Type seconds) const{
+        const auto begin = empty() ? size_t{} : lower_bound(back().time() - seconds);
+        return std::views::iota(begin, size_) | std::views::transform([this](size_t i) -> const Point &{
+            return at(i);
+        });
+    }
+
+    //Линейная интерполяция положения на заданный момент времени внутри истории
+    std::optional<Point> interpolate(Type time) const{
+        if(empty() || (time < at(0).time()) || (time > back().time())){
+            return std::nullopt;
+        }
+        const auto index = lower_bound(time);
+        const auto &next = at(index);
+        if((index == 0) || algorithm::compare(next.time(), time)){
+            return next;
+        }
+        const auto &prior = at(index - 1);
+        const auto k = (time - prior.time()) / (next.time() - prior.time());
+        return Point(prior.x() + k * (next.x() - prior.x()),
+                     prior.y() + k * (next.y() - prior.y()),
+                     prior.h() + k * (next.h() - prior.h()),
+                     time);
+    }
+
+    //Оценка скорости по последней отметке и отметке не позже чем seconds единиц времени назад
+    std::optional<track_velocity<Type>> velocity(Type seconds) const{
+        if(size_ < 2){
+            return std::nullopt;
+        }
+        const auto &last = back();
+        auto index = lower_bound(last.time() - seconds);
+        if(index + 1 >= size_){
+            index = size_ - 2;
+        }
+        else if((index > 0) && (at(index).time() > last.time() - seconds)){
+            --index;
+        }
+        const auto &prior = at(index);
+        const auto dt = last.time() - prior.time();
+        return track_velocity<Type>{point_algo::distance(prior, last) / dt,
+                                    point_algo::angle(prior, last),
+                                    (last.h() - prior.h()) / dt};
+    }
+
+private:
+    //Индекс первой отметки со временем не меньше time
+    size_t lower_bound(Type time) const{
+        const auto numbers = std::views::iota(size_t(), size_);
+        return *std::ranges::lower_bound(numbers, time, std::less{}, [this](size_t i){
+            return at(i).time();
+        });
+    }
+
+    spsc_ring_buffer<Point> ingest_;
+    std::vector<Point> history_;
+    size_t first_{};
+    size_t size_{};
+};
+
+//Хранилище треков. Регистрация трека защищена мьютексом, ссылка на трек стабильна,
+//поэтому писатель получает её один раз и дальше добавляет отметки без блокировок
+template<c_point4d_decard Point, typename Key = size_t>
+class track_store{
+public:
+    using track = track_impl<Point>;
+
+    explicit track_store(size_t capacity = 1024, size_t ingest_capacity = 256)
+        : capacity_(capacity), ingest_capacity_(ingest_capacity){}
+
+    track &get(const Key &key){
+        std::lock_guard lock(mutex_);
+        auto &item = tracks_[key];
+        if(!item){
+            item = std::make_unique<track>(capacity_, ingest_capacity_);
+        }
+        return *item;
+    }
+
+    size_t size() const{
+        std::lock_guard lock(mutex_);
+        return tracks_.size();
+    }
+
+    //Поток читателя. Переносит принятые отметки всех треков в историю
+    size_t poll(){
+        size_t count{};
+        for_each([&count](const Key &, track &item){
+            count += item.poll();
+        });
+        return count;
+    }
+
+    template<typename Func>
+    void for_each(Func &&func){
+        std::lock_guard lock(mutex_);
+        for(auto &[key, item] : tracks_){
+            func(key, *item);
+        }
+    }
+
+private:
+    size_t capacity_;
+    size_t ingest_capacity_;
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::unique_ptr<track>> tracks_;
+};
+
+}
+
+#endif // TRACK_IMPL_H
@@ -39,6 +39,8 @@ public:
     constexpr vector(){
         std::ranges::fill(*this, Type{});
     }
+    //Элементы не заполняются: для результатов, которые сразу перезаписываются целиком
+    constexpr explicit vector(uninitialized_t){}
     constexpr vector(std::initializer_list<Type> list){
         std::ranges::copy(list, begin());
         std::ranges::fill(std::next(begin(), list.size()), end(), Type{});
@@ -53,14 +55,14 @@ public:
     }
 
     constexpr friend auto operator+(const vector<Type, Count> &vector_1, const vector<Type, Count> &vector_2) -> vector<Type, Count>{
-        vector<Type, Count> temp;
-        std::ranges::transform(vector_1, vector_2, temp.begin(), std::plus{});
+        vector<Type, Count> temp(uninitialized);
+        std::transform(vector_1.begin(), vector_1.end(), vector_2.begin(), temp.begin(), std::plus{});
         return temp;
     }
 
     constexpr friend auto operator-(const vector<Type, Count> &vector_1, const vector<Type, Count> &vector_2) -> vector<Type, Count>{
-        vector<Type, Count> temp;
-        std::ranges::transform(vector_1, vector_2, temp.begin(), std::minus{});
+        vector<Type, Count> temp(uninitialized);
+        std::transform(vector_1.begin(), vector_1.end(), vector_2.begin(), temp.begin(), std::minus{});
         return temp;
     }
 
@@ -0,0 +1,77 @@
+#ifndef SPSC_RING_BUFFER_H
+#define SPSC_RING_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace agl{
+
+//Кольцевой буфер без блокировок для одного писателя и одного читателя.
+//push вызывается только из потока писателя, pop - только из потока читателя
+template<typename Value>
+class spsc_ring_buffer{
+public:
+    explicit spsc_ring_buffer(size_t capacity)
+        : buffer_(std::bit_ceil(std::max<size_t>(capacity, 2))), mask_(buffer_.size() - 1){}
+
+    spsc_ring_buffer(const spsc_ring_buffer &) = delete;
+    spsc_ring_buffer &operator=(const spsc_ring_buffer &) = delete;
+
+    size_t capacity() const{
+        return buffer_.size();
+    }
+
+    //Возвращает false, если буфер заполнен
+    bool push(const Value &value){
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if(tail - head_cache_ == buffer_.size()){
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if(tail - head_cache_ == buffer_.size()){
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<Value> pop(){
+        const auto head = head_.load(std::memory_order_relaxed);
+        if(head == tail_cache_){
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if(head == tail_cache_){
+                return std::nullopt;
+            }
+        }
+        auto value = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    //Приблизительный размер: точен только в потоке писателя или читателя
+    size_t size() const{
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const{
+        return size() == 0;
+    }
+
+private:
+    static constexpr size_t cache_line = 64;
+
+    std::vector<Value> buffer_;
+    const size_t mask_;
+
+    alignas(cache_line) std::atomic<size_t> head_{};  //!Индекс чтения, изменяет читатель
+    size_t tail_cache_{};                             //!Копия tail_ у читателя
+    alignas(cache_line) std::atomic<size_t> tail_{};  //!Индекс записи, изменяет писатель
+    size_t head_cache_{};                             //!Копия head_ у писателя
+};
+
+}
+
+#endif // SPSC_RING_BUFFER_H
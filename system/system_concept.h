@@ -44,6 +44,11 @@ concept c_point3d_geo = requires(Type temp){
 template<typename Type>
 concept c_point3d = c_point3d_decard<Type> || c_point3d_geo<Type>;
 
+template<typename Type>
+concept c_point4d_decard = c_point2d_decard<Type> && requires(Type temp){
+    temp.h(); temp.time();
+};
+
 template<typename Type>
 concept c_polar2d = requires(Type temp){
     temp.psi(); temp.fi();
@@ -79,6 +84,20 @@ concept c_function_angle = requires(){
     ClassFunctions::atan2(Type(), Type());
 };
 
+template<typename Ellipsoid>
+concept c_ellipsoid = requires(){
+    typename Ellipsoid::type;
+    Ellipsoid::semimajor_axis;
+    Ellipsoid::semiminor_axis;
+    Ellipsoid::mean_radius;
+    Ellipsoid::eccentricity2;
+    Ellipsoid::eccentricity2_1;
+    Ellipsoid::eccentricity2_2;
+    Ellipsoid::axis_ratio;
+    Ellipsoid::longitude_c1;
+    Ellipsoid::longitude_c2;
+};
+
 template<typename Type>
 concept c_straight_line = requires(Type temp){
     temp.a();
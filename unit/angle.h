@@ -35,7 +35,7 @@ public:
 
     constexpr angle_impl &asin(const Type &value){
         if (algorithm::interval_strict(value, -1.0, 1.0)){
-            radian_ = algorithm::function_angle<Type>::asin(value);
+            radian_ = ClassFunc::asin(value);
             return *this;
         }
         else{
@@ -44,7 +44,7 @@ public:
     }
     constexpr angle_impl &acos(const Type &value){
         if(algorithm::interval_strict(value, -1.0, 1.0)){
-            radian_ = algorithm::function_angle<Type>::acos(value);
+            radian_ = ClassFunc::acos(value);
             return *this;
         }
         else{
@@ -53,25 +53,25 @@ public:
 
     }
     constexpr angle_impl &atan(const Type &value){
-        radian_ = algorithm::function_angle<Type>::atan(value);
+        radian_ = ClassFunc::atan(value);
         return *this;
     }
     constexpr angle_impl &actan(const Type &value){
-        radian_ = algorithm::pi_on_2<Type> + algorithm::function_angle<Type>::atan(-value);
+        radian_ = algorithm::pi_on_2<Type> + ClassFunc::atan(-value);
         return *this;
     }
 
     constexpr Type sin() const{
-        return algorithm::function_angle<Type>::sin(radian_);
+        return ClassFunc::sin(radian_);
     }
     constexpr Type cos() const{
-        return algorithm::function_angle<Type>::cos(radian_);
+        return ClassFunc::cos(radian_);
     }
     constexpr Type tan() const{
-        return algorithm::function_angle<Type>::tan(radian_);
+        return ClassFunc::tan(radian_);
     }
     constexpr Type ctan() const{
-        return 1.0 / algorithm::function_angle<Type>::tan(radian_);
+        return 1.0 / ClassFunc::tan(radian_);
     }
 
     template<std::floating_point Type_Value, c_function_angle<Type_Value> Algo_Value = algorithm::function_angle<Type_Value>>
@@ -2,16 +2,24 @@
 #include <QtTest/QTest>
 #include "algorithm/approximation_algorithm.h"
 #include "algorithm/circle_algorithm.h"
+#include "algorithm/cpa_algorithm.h"
+#include "algorithm/eigen_algorithm.h"
 #include "algorithm/geo_algorithm.h"
 #include "algorithm/point_algorithm.h"
 #include "algorithm/line_algorithm.h"
 #include "algorithm/polygon_algorithm.h"
+#include "algorithm/projection_algorithm.h"
+#include "algorithm/simplification_algorithm.h"
 
 #include "unit/distance.h"
 
 
 #include "qtestcase.h"
+#include "structs/geo_index_impl.h"
 #include "structs/matrix.h"
+#include "structs/matrix_batch.h"
+#include "structs/sparse_matrix.h"
+#include "structs/track_impl.h"
 #include "structs/vector.h"
 #include "unit/speed.h"
 #include "unit/temperature.h"
@@ -19,6 +27,9 @@
 #include "unit/weight.h"
 #include "user_type.h"
 
+#include <random>
+#include <thread>
+
 using namespace agl;
 
 Unit_Test::Unit_Test(QObject *parent) : QObject{parent}{}
@@ -109,6 +120,39 @@ void Unit_Test::test_angle()
             QVERIFY(angle.actan(angle.ctan()) == 0._deg);
         }
     }
+
+    {//fast_function_angle
+        using Fast = algorithm::fast_function_angle<double>;
+        using FastF = algorithm::fast_function_angle<float>;
+        bool is_equal = true;
+        for(double x = -1000.; x < 1000.; x += 0.0137){
+            const auto [s, c] = Fast::sincos(x);
+            is_equal = is_equal && (std::abs(s - std::sin(x)) < 1e-12) && (std::abs(c - std::cos(x)) < 1e-12);
+            is_equal = is_equal && (std::abs(FastF::sin(float(x)) - std::sin(float(x))) < 1e-4f);
+            is_equal = is_equal && (std::abs(Fast::atan(x) - std::atan(x)) < 1e-15);
+            is_equal = is_equal && (std::abs(Fast::atan2(x, 17. - x) - std::atan2(x, 17. - x)) < 1e-15);
+        }
+        for(double x = -1.; x <= 1.; x += 0.001){
+            is_equal = is_equal && (std::abs(Fast::asin(x) - std::asin(x)) < 1e-15);
+            is_equal = is_equal && (std::abs(Fast::acos(x) - std::acos(x)) < 1e-15);
+        }
+        QVERIFY(is_equal);
+        QVERIFY(algorithm::compare(Fast::atan2(0., -1.), algorithm::pi<double>));
+        QVERIFY(algorithm::compare(Fast::atan2(-1., 0.), -algorithm::pi_on_2<double>));
+        QVERIFY(algorithm::compare(Fast::atan2(0., 0.), 0.));
+        QVERIFY(algorithm::compare(Fast::tan(0.5), std::tan(0.5)));
+        QVERIFY(algorithm::compare(Fast::actan(2.), algorithm::function_angle<double>::actan(2.)));
+
+        //Вычисление при компиляции и значения вне области приведения аргумента
+        constexpr auto sincos_half = Fast::sincos(0.5);
+        static_assert((sincos_half.first > 0.479) && (sincos_half.first < 0.48));
+        QVERIFY((Fast::sin(1e300) == std::sin(1e300)) && (Fast::cos(-1e300) == std::cos(-1e300)));
+        QVERIFY(std::isnan(Fast::sin(std::numeric_limits<double>::quiet_NaN())));
+        QVERIFY(std::isnan(FastF::cos(std::numeric_limits<float>::infinity())));
+
+        angle_impl<double, Fast> angle = (30._deg).radian();
+        QVERIFY(algorithm::compare(angle.sin(), 0.5));
+    }
 }
 
 void Unit_Test::test_unit()
@@ -543,6 +587,14 @@ void Unit_Test::test_point_algorithm()
         QVERIFY(algorithm::compare(value.y(), 0.));
     }
 
+    {//fast_function_angle
+        using Fast = algorithm::fast_function_angle<double>;
+        auto value = point_algo::new_point<Point, double, double, Fast>(Point{10,10}, (30._deg).radian(), 10.);
+        QVERIFY(value == point_algo::new_point(Point{10,10}, (30._deg).radian(), 10.));
+        value = point_algo::rotate<Point, double, Fast>(Point{10,10}, (90._deg).radian(), Point{5,5});
+        QVERIFY(value == Point(10, 0));
+    }
+
     {
         auto value = point_algo::midplane(Point{10,10}, Point{5,5});
         QVERIFY(algorithm::compare(value.x(), 7.5));
@@ -1386,6 +1438,260 @@ void Unit_Test::test_polygon_algorithm()
     }
 }
 
+void Unit_Test::test_polyline()
+{
+    {
+        Polyline polyline{Point(0,0), Point(0,10), Point(10,10), Point(10,0)};
+        QVERIFY(polyline.count() == 3);
+        QVERIFY(algorithm::compare(polyline.length(), 30.));
+        QVERIFY(polyline.segment_index(15.).value() == 1);
+        QVERIFY(polyline.point_at(0.).value() == Point(0, 0));
+        QVERIFY(polyline.point_at(10.).value() == Point(0, 10));
+        QVERIFY(polyline.point_at(15.).value() == Point(5, 10));
+        QVERIFY(polyline.point_at(30.).value() == Point(10, 0));
+        QVERIFY(!polyline.point_at(31.).has_value());
+        QVERIFY(!polyline.point_at(-1.).has_value());
+
+        QVERIFY(algorithm::compare(polyline.distance_along(Point(4, 12)).value(), 14.));
+        QVERIFY(algorithm::compare(polyline.distance_along(Point(12, 3)).value(), 27.));
+        QVERIFY(algorithm::compare(polyline.distance_along(Point(4, 12), 0).value(), 10.));
+
+        auto points = polyline.resample(7.);
+        QVERIFY(points.size() == 5);
+        QVERIFY(points[1] == Point(0, 7));
+        QVERIFY(points[2] == Point(4, 10));
+        QVERIFY(points[4] == Point(10, 2));
+    }
+
+    {
+        Polyline polyline;
+        polyline.append(Point(-10, 0));
+        polyline.append(Point(0, 0));
+        polyline.append(Arc(Point(0, -10), 10., 0_deg, 90_deg));
+        polyline.append(Point(10, -20));
+        QVERIFY(polyline.count() == 3);
+        QVERIFY(algorithm::compare(polyline.length(), 20. + 5. * algorithm::pi<double>));
+        QVERIFY(polyline.point_at(10. + 2.5 * algorithm::pi<double>).value() == Point(7.071068, -2.928932));
+        QVERIFY(polyline.point_at(polyline.length()).value() == Point(10, -20));
+        QVERIFY(algorithm::compare(polyline.distance_along(Point(20, -10)).value(), 10. + 5. * algorithm::pi<double>));
+    }
+
+    {
+        Polyline polyline;
+        polyline.append(Arc(Point(0, 0), 10., 90_deg, 0_deg), algorithm::direct::LEFT);
+        QVERIFY(algorithm::compare(polyline.length(), 5. * algorithm::pi<double>));
+        QVERIFY(polyline.point_at(0.).value() == Point(10, 0));
+        QVERIFY(polyline.point_at(2.5 * algorithm::pi<double>).value() == Point(7.071068, 7.071068));
+        QVERIFY(polyline.point_at(polyline.length()).value() == Point(0, 10));
+        QVERIFY(algorithm::compare(polyline.distance_along(Point(0, 20)).value(), 5. * algorithm::pi<double>));
+    }
+}
+
+void Unit_Test::test_simplification()
+{
+    {//douglas_peucker
+        auto points = std::vector{Point(0,0), Point(1,0.1), Point(2,-0.1), Point(3,0.05), Point(4,0)};
+        QVERIFY(simplification_algo::douglas_peucker(points, 0.5) == std::vector({Point(0,0), Point(4,0)}));
+
+        points = std::vector{Point(0,0), Point(1,2.4), Point(2,5), Point(3,2.6), Point(4,0)};
+        auto result = std::vector({Point(0,0), Point(2,5), Point(4,0)});
+        QVERIFY(simplification_algo::douglas_peucker(points, 0.5) == result);
+        QVERIFY(simplification_algo::douglas_peucker(points, 0.01) == points);
+
+        auto cloud = simplification_algo::douglas_peucker(PointCloud(points), 0.5);
+        QVERIFY(cloud.size() == 3);
+        QVERIFY(cloud.point<Point>(1) == Point(2,5));
+    }
+
+    {//douglas_peucker_parallel
+        std::vector<Point> points;
+        for(int i = 0; i < 100'000; ++i){
+            points.emplace_back(i, 50. * std::sin(i / 100.));
+        }
+        const auto tolerance = 0.2;
+        auto serial = simplification_algo::douglas_peucker(points, tolerance);
+        auto parallel = simplification_algo::douglas_peucker_parallel(points, tolerance, 4, 1000);
+        QVERIFY(parallel.front() == points.front());
+        QVERIFY(parallel.back() == points.back());
+        QVERIFY(parallel.size() < serial.size() + serial.size() / 10);
+
+        bool is_inside = true;
+        size_t index = 0;
+        for(const auto &point : points){
+            while(parallel[index + 1].x() < point.x()){
+                ++index;
+            }
+            auto line = LineSection(parallel[index], parallel[index + 1]);
+            is_inside = is_inside && (std::abs(line_algo::distance_to_line(view_line(line), point)) <= tolerance + algorithm::epsilon_d);
+        }
+        QVERIFY(is_inside);
+    }
+
+    {//visvalingam
+        auto points = std::vector{Point(0,0), Point(1,0.1), Point(2,0), Point(3,3), Point(4,0)};
+        auto result = std::vector({Point(0,0), Point(2,0), Point(3,3), Point(4,0)});
+        QVERIFY(simplification_algo::visvalingam(points, 1.) == result);
+        QVERIFY(simplification_algo::visvalingam(points, 0.05) == points);
+        QVERIFY(simplification_algo::visvalingam(points, 10.) == std::vector({Point(0,0), Point(4,0)}));
+        QVERIFY(simplification_algo::visvalingam(PointCloud(points), 1.).size() == 4);
+    }
+
+    {//stream_simplifier
+        auto points = std::vector{Point(0,0), Point(1,2.4), Point(2,5), Point(3,2.6), Point(4,0)};
+        simplification_algo::stream_simplifier<Point> simplifier(0.5);
+        std::vector<Point> result;
+        for(const auto &point : points){
+            if(auto vertex = simplifier.push(point); vertex.has_value()){
+                result.push_back(vertex.value());
+            }
+        }
+        if(auto vertex = simplifier.flush(); vertex.has_value()){
+            result.push_back(vertex.value());
+        }
+        QVERIFY(result == std::vector({Point(0,0), Point(2,5), Point(4,0)}));
+        QVERIFY(!simplifier.flush().has_value());
+    }
+}
+
+void Unit_Test::test_track()
+{
+    {//spsc_ring_buffer
+        spsc_ring_buffer<int> buffer(3);
+        QVERIFY(buffer.capacity() == 4);
+        QVERIFY(!buffer.pop().has_value());
+        QVERIFY(buffer.push(1) && buffer.push(2) && buffer.push(3) && buffer.push(4));
+        QVERIFY(!buffer.push(5));
+        QVERIFY(buffer.size() == 4);
+        QVERIFY(buffer.pop().value() == 1);
+        QVERIFY(buffer.push(5));
+        QVERIFY(buffer.pop().value() == 2);
+        QVERIFY(buffer.pop().value() == 3);
+        QVERIFY(buffer.pop().value() == 4);
+        QVERIFY(buffer.pop().value() == 5);
+        QVERIFY(buffer.empty());
+    }
+
+    {
+        track_impl<Point4d> track(4);
+        QVERIFY(!track.interpolate(0.).has_value());
+        QVERIFY(!track.velocity(1.).has_value());
+        for(int i = 0; i < 6; ++i){
+            track.push(Point4d(0., 100. * i, 10. * i, double(i)));
+        }
+        track.push(Point4d(0., 0., 0., 1.));
+        QVERIFY(track.poll() == 6);
+        QVERIFY(track.size() == 4);
+        QVERIFY(algorithm::compare(track.at(0).time(), 2.));
+        QVERIFY(algorithm::compare(track.back().time(), 5.));
+
+        auto window = track.window(1.5);
+        QVERIFY(std::ranges::distance(window) == 2);
+        QVERIFY(algorithm::compare((*window.begin()).time(), 4.));
+
+        auto point = track.interpolate(3.25);
+        QVERIFY(point.has_value());
+        QVERIFY(algorithm::compare(point->y(), 325.));
+        QVERIFY(algorithm::compare(point->h(), 32.5));
+        QVERIFY(!track.interpolate(1.).has_value());
+        QVERIFY(algorithm::compare(track.interpolate(5.)->y(), 500.));
+
+        auto velocity = track.velocity(2.);
+        QVERIFY(velocity.has_value());
+        QVERIFY(algorithm::compare(velocity->ground_speed, 100.));
+        QVERIFY(algorithm::compare(velocity->course, 0.));
+        QVERIFY(algorithm::compare(velocity->vertical_speed, 10.));
+    }
+
+    {
+        track_store<Point4d> store(100'000, 64);
+        auto &track = store.get(7);
+        QVERIFY(&track == &store.get(7));
+        QVERIFY(store.size() == 1);
+
+        const int count = 50'000;
+        std::thread producer([&track](){
+            for(int i = 0; i < count; ++i){
+                while(!track.push(Point4d(double(i), 0., 0., double(i)))){
+                    std::this_thread::yield();
+                }
+            }
+        });
+        size_t received{};
+        while(received < count){
+            received += store.poll();
+        }
+        producer.join();
+        QVERIFY(track.size() == count);
+        bool is_order = true;
+        for(int i = 0; i < count; ++i){
+            is_order = is_order && algorithm::compare(track.at(i).x(), double(i));
+        }
+        QVERIFY(is_order);
+        QVERIFY(algorithm::compare(track.velocity(10.)->course, algorithm::pi_on_2<double>));
+    }
+}
+
+void Unit_Test::test_cpa()
+{
+    {//make_motion
+        auto motion = cpa_algo::make_motion(Point4d(0., 0., 100., 0.), Point4d(10., 20., 110., 2.));
+        QVERIFY(algorithm::compare(motion.vx, 5.));
+        QVERIFY(algorithm::compare(motion.vy, 10.));
+        QVERIFY(algorithm::compare(motion.vh, 5.));
+        QVERIFY(algorithm::compare(motion.x_at(4.), 20.));
+    }
+
+    {//cpa
+        auto result = cpa_algo::cpa(Point4d(0., 0., 0., 0.), Point4d(0., 10., 0., 1.),
+                                    Point4d(100., 50., 0., 0.), Point4d(90., 50., 0., 1.), 0., 100.);
+        QVERIFY(algorithm::compare(result.time, 7.5));
+        QVERIFY(algorithm::compare(result.distance, std::hypot(25., 25.)));
+
+        result = cpa_algo::cpa(Point4d(0., 0., 0., 0.), Point4d(0., 10., 0., 1.),
+                               Point4d(100., 50., 0., 0.), Point4d(90., 50., 0., 1.), 0., 2.);
+        QVERIFY(algorithm::compare(result.time, 2.));
+        QVERIFY(algorithm::compare(result.distance, std::hypot(80., 30.)));
+
+        result = cpa_algo::cpa(Point4d(0., 0., 0., 0.), Point4d(0., 0., 0., 1.),
+                               Point4d(3., 4., 0., 0.), Point4d(3., 4., 0., 1.), 0., 10.);
+        QVERIFY(algorithm::compare(result.time, 0.));
+        QVERIFY(algorithm::compare(result.distance, 5.));
+    }
+
+    {//conflicts
+        std::mt19937 generator(17);
+        std::uniform_real_distribution<double> position(0., 100'000.);
+        std::uniform_real_distribution<double> speed(-250., 250.);
+        std::vector<cpa_algo::linear_motion<double>> motions;
+        for(int i = 0; i < 2000; ++i){
+            motions.push_back({position(generator), position(generator), 0., 0., speed(generator), speed(generator), 0.});
+        }
+        const auto threshold = 1000.;
+        std::vector<std::pair<size_t, size_t>> brute;
+        for(size_t i = 0; i < motions.size(); ++i){
+            for(size_t j = i + 1; j < motions.size(); ++j){
+                if(cpa_algo::cpa(motions[i], motions[j], 0., 60.).distance < threshold){
+                    brute.emplace_back(i, j);
+                }
+            }
+        }
+        auto to_pairs = [](const auto &result){
+            std::vector<std::pair<size_t, size_t>> pairs;
+            for(const auto &item : result){
+                pairs.emplace_back(item.first, item.second);
+            }
+            return pairs;
+        };
+        auto serial = cpa_algo::conflicts(motions, threshold, 0., 60.);
+        QVERIFY(!brute.empty());
+        QVERIFY(to_pairs(serial) == brute);
+        QVERIFY(to_pairs(cpa_algo::conflicts(motions, threshold, 0., 60., 4)) == brute);
+        QVERIFY(std::ranges::all_of(serial, [threshold](const auto &item){
+            return (item.cpa.distance < threshold) && algorithm::interval_strict(item.cpa.time, 0., 60.);
+        }));
+    }
+}
+
 void Unit_Test::test_geo_algorithm()
 {
     {//common_survey_comp
@@ -1408,6 +1714,11 @@ void Unit_Test::test_geo_algorithm()
         value = geo_algo::common_survey_comp(5'000'000., (30_deg).radian(), PointGeo(10_deg, 20_deg));
         QVERIFY(value.latitude_angle() == 46.492402_deg);
         QVERIFY(value.longitude_angle() == 51.053114_deg);
+
+        value = geo_algo::common_survey_comp<double, double, PointGeo, algorithm::fast_function_angle<double>>(
+            5'000'000., (30_deg).radian(), PointGeo(10_deg, 20_deg));
+        QVERIFY(value.latitude_angle() == 46.492402_deg);
+        QVERIFY(value.longitude_angle() == 51.053114_deg);
     }
 
     {//geographic_inverse
@@ -1423,6 +1734,10 @@ void Unit_Test::test_geo_algorithm()
             Polar2d polar(std::get<0>(value), std::get<1>(value));
             QVERIFY(algorithm::compare(polar.psi(), 1541490.960101));
             QVERIFY(polar.angle_fi() == 42.635007_deg);
+
+            value = geo_algo::geographic_inverse<PointGeo, algorithm::fast_function_angle<double>>(PointGeo(10_deg, 10_deg), PointGeo(20_deg, 20_deg));
+            QVERIFY(algorithm::compare(std::get<0>(value), 1541490.960101));
+            QVERIFY(Angle(std::get<1>(value)) == 42.635007_deg);
         }
 
         {
@@ -1503,6 +1818,539 @@ void Unit_Test::test_geo_algorithm()
         auto points = std::vector{LineSection{Point(0,0), Point(0,10)}, LineSection{Point(10,10), Point(10,0)}};
         auto geo_points = geo_algo::convert<LineSectionGeo>(points, PointGeo(0_deg, 0_deg));
     }
+
+    {//ecef, geodetic
+        const PointGeo point(55.75_deg, 37.6_deg);
+        auto value = geo_algo::ecef(0., algorithm::pi_on_2<double>, 100.);
+        QVERIFY(algorithm::compare(value[0], 0.));
+        QVERIFY(algorithm::compare(value[1], 6378236.));
+        QVERIFY(algorithm::compare(value[2], 0.));
+
+        value = geo_algo::geodetic(geo_algo::ecef(point.latitude(), point.longitude(), 1500.));
+        QVERIFY(Angle(value[0]) == 55.75_deg);
+        QVERIFY(Angle(value[1]) == 37.6_deg);
+        QVERIFY(algorithm::compare(value[2], 1500.));
+    }
+
+    {//ellipsoid
+        static_assert(pz90<double>::semimajor_axis == 6378136.);
+        static_assert(pz90<double>::semiminor_axis == 6356751.362);
+        static_assert(algorithm::compare_common(1 / wgs84<double>::flattening, 298.257223563, 1e-6));
+        static_assert(algorithm::compare_common(krasovsky<double>::eccentricity2, 0.006693421622, 1e-12));
+        static_assert(algorithm::compare_common(wgs84<double>::axis_ratio * wgs84<double>::axis_ratio,
+                                         1 - wgs84<double>::eccentricity2_1, 1e-15));
+
+        auto value = geo_algo::ecef<double, algorithm::function_angle<double>, krasovsky<double>>(0., 0.);
+        QVERIFY(algorithm::compare(value[0], 6378245.));
+
+        const PointGeo start(10_deg, 10_deg);
+        const PointGeo stop(20_deg, 20_deg);
+        auto [range_pz90, omnibearing_pz90] = geo_algo::geographic_inverse(start, stop);
+        auto [range_wgs84, omnibearing_wgs84] = geo_algo::geographic_inverse<PointGeo, algorithm::function_angle<double>, wgs84<double>>(start, stop);
+        QVERIFY(!algorithm::compare(range_pz90, range_wgs84));
+        QVERIFY(std::abs(range_pz90 - range_wgs84) < 1.);
+        QVERIFY(Angle(omnibearing_pz90) == Angle(omnibearing_wgs84));
+
+        auto point_pz90 = geo_algo::common_survey_comp(range_pz90, omnibearing_pz90, start);
+        auto point_wgs84 = geo_algo::common_survey_comp<double, double, PointGeo, algorithm::function_angle<double>, wgs84<double>>(
+            range_pz90, omnibearing_pz90, start);
+        const auto shift = std::abs(point_pz90.latitude() - point_wgs84.latitude());
+        QVERIFY((shift > 0.) && (shift < 1e-7));
+    }
+
+    {//spherical_inverse, within, proximity
+        auto [range, omnibearing] = geo_algo::spherical_inverse(PointGeo(0_deg, 0_deg), PointGeo(0_deg, 1_deg));
+        QVERIFY(algorithm::compare(range, pz90<double>::mean_radius * algorithm::pi<double> / 180));
+        QVERIFY(Angle(omnibearing) == 90_deg);
+
+        const PointGeo start(10_deg, 10_deg);
+        const PointGeo stop(20_deg, 20_deg);
+        std::tie(range, omnibearing) = geo_algo::spherical_inverse(start, stop);
+        auto [range_ellipsoid, omnibearing_ellipsoid] = geo_algo::geographic_inverse(start, stop);
+        QVERIFY(std::abs(range - range_ellipsoid) < range_ellipsoid * geo_algo::spherical_error<double>);
+        QVERIFY(std::abs(omnibearing - omnibearing_ellipsoid) < (0.5_deg).radian());
+        QVERIFY(algorithm::compare(geo_algo::spherical_range(geo_algo::unit_vector(start), geo_algo::unit_vector(stop)), range));
+
+        //Порог между сферической и эллипсоидальной дальностью попадает в полосу: решение даёт эллипсоид
+        const auto threshold = (range + range_ellipsoid) / 2;
+        QVERIFY(geo_algo::within(start, stop, threshold) == (range_ellipsoid < threshold));
+        QVERIFY(geo_algo::within(start, stop, threshold, 0.) == (range < threshold));
+        QVERIFY(geo_algo::within(start, stop, std::max(range, range_ellipsoid) + 1.));
+        QVERIFY(!geo_algo::within(start, stop, std::min(range, range_ellipsoid) - 1.));
+
+        std::mt19937 generator(5);
+        std::uniform_real_distribution<double> latitude(0.9, 1.0);
+        std::uniform_real_distribution<double> longitude(0.6, 0.7);
+        std::vector<PointGeo> points;
+        for(int i = 0; i < 300; ++i){
+            points.emplace_back(latitude(generator), longitude(generator));
+        }
+        const auto limit = 185'200.;
+        std::vector<std::pair<size_t, size_t>> brute;
+        for(size_t i = 0; i < points.size(); ++i){
+            for(size_t j = i + 1; j < points.size(); ++j){
+                if(std::get<0>(geo_algo::geographic_inverse(points[i], points[j])) < limit){
+                    brute.emplace_back(i, j);
+                }
+            }
+        }
+        QVERIFY(!brute.empty());
+        QVERIFY(geo_algo::proximity(points, limit) == brute);
+    }
+
+    {//distance_matrix
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<double> latitude(-1.2, 1.2);
+        std::uniform_real_distribution<double> longitude(-3., 3.);
+        std::vector<PointGeo> airports;
+        std::vector<PointGeo> aircraft;
+        for(int i = 0; i < 70; ++i){
+            airports.emplace_back(latitude(generator), longitude(generator));
+        }
+        for(int i = 0; i < 45; ++i){
+            aircraft.emplace_back(latitude(generator), longitude(generator));
+        }
+        aircraft.push_back(airports.front());
+
+        dynamic_matrix<double> expected(airports.size(), aircraft.size());
+        for(size_t i = 0; i < airports.size(); ++i){
+            for(size_t j = 0; j < aircraft.size(); ++j){
+                expected.value(i, j) = std::get<0>(geo_algo::geographic_inverse(airports[i], aircraft[j]));
+            }
+        }
+        dynamic_matrix<double> matrix(airports.size(), aircraft.size());
+        geo_algo::distance_matrix(airports, aircraft, matrix);
+        QVERIFY(matrix == expected);
+        QVERIFY(matrix.value(0, aircraft.size() - 1) == 0.);
+
+        dynamic_matrix<double> parallel(airports.size(), aircraft.size());
+        geo_algo::distance_matrix(airports, aircraft, parallel, 4);
+        QVERIFY(parallel == expected);
+
+        //Строки с шагом больше числа столбцов, хвост строки не изменяется
+        const size_t stride = aircraft.size() + 3;
+        std::vector<double> buffer(airports.size() * stride, -1.);
+        geo_algo::distance_matrix(airports, aircraft, std::span(buffer), stride, 3, 16);
+        bool strided = true;
+        for(size_t i = 0; i < airports.size(); ++i){
+            for(size_t j = 0; j < stride; ++j){
+                strided &= (j < aircraft.size()) ? algorithm::compare(buffer[i * stride + j], expected.value(i, j))
+                                                 : (buffer[i * stride + j] == -1.);
+            }
+        }
+        QVERIFY(strided);
+
+        dynamic_matrix<double> symmetric(airports.size(), airports.size(), -1.);
+        geo_algo::distance_matrix(airports, symmetric, 3);
+        bool valid = true;
+        for(size_t i = 0; i < airports.size(); ++i){
+            valid &= (symmetric.value(i, i) == 0.);
+            for(size_t j = i + 1; j < airports.size(); ++j){
+                valid &= (symmetric.value(i, j) == symmetric.value(j, i));
+                valid &= algorithm::compare(symmetric.value(i, j), std::get<0>(geo_algo::geographic_inverse(airports[i], airports[j])));
+            }
+        }
+        QVERIFY(valid);
+
+        bool thrown = false;
+        try{
+            dynamic_matrix<double> small(2, 2);
+            geo_algo::distance_matrix(airports, aircraft, small);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//densify(line_section_geo)
+        const LineSectionGeo line(PointGeo(55.75_deg, 37.6_deg), PointGeo(40.7_deg, -74._deg));
+        const auto [range, omnibearing] = geo_algo::geographic_inverse(line.start(), line.stop());
+        auto points = geo_algo::densify(line, 100);
+        QVERIFY(points.size() == 101);
+        QVERIFY((points.front() == line.start()) && (points.back() == line.stop()));
+        bool valid = true;
+        for(size_t i = 1; i < 100; ++i){
+            valid &= (points[i] == geo_algo::common_survey_comp(range * i / 100, omnibearing, line.start()));
+        }
+        QVERIFY(valid);
+
+        std::vector<PointGeo> buffer(5, PointGeo(0., 0.));
+        geo_algo::densify(line, std::span(buffer));
+        QVERIFY(buffer[2] == geo_algo::common_survey_comp(range / 2, omnibearing, line.start()));
+
+        const auto count = geo_algo::densify_count(LineSectionGeo(PointGeo(0_deg, 0_deg), PointGeo(0_deg, 10_deg)), 100.);
+        QVERIFY(count == 16);
+        QVERIFY(geo_algo::densify_tolerance(line, 1000.).size() == geo_algo::densify_count(line, 1000.) + 1);
+        QVERIFY(geo_algo::densify_count(line, 0.) == 1);
+    }
+
+    {//densify(arc_geo)
+        const ArcGeo arc(PointGeo(50_deg, 10_deg), 100'000., 350_deg, 80_deg);
+        auto points = geo_algo::densify(arc, 9);
+        QVERIFY(points.size() == 10);
+        QVERIFY(points.front() == geo_algo::common_survey_comp(100'000., arc.start(), arc.center()));
+        QVERIFY(points.back() == geo_algo::common_survey_comp(100'000., arc.stop(), arc.center()));
+        QVERIFY(points[1] == geo_algo::common_survey_comp(100'000., (0_deg).radian(), arc.center()));
+
+        auto left = geo_algo::densify(arc, 27, algorithm::direct::LEFT);
+        QVERIFY(left.front() == points.back());
+        QVERIFY(left.back() == points.front());
+
+        QVERIFY(geo_algo::densify_count(arc, 10.) == 56);
+        QVERIFY(geo_algo::densify_count(arc, 10., algorithm::direct::LEFT) == 167);
+        QVERIFY(geo_algo::densify_tolerance(arc, 10.).size() == 57);
+    }
+
+    {//point_geo2d_prepared
+        static_assert(c_point2d_geo<PointGeoPrepared>);
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<double> latitude(-1.4, 1.4);
+        std::uniform_real_distribution<double> longitude(-3., 3.);
+        std::vector<PointGeo> points;
+        for(int i = 0; i < 40; ++i){
+            points.emplace_back(latitude(generator), longitude(generator));
+        }
+        auto prepared = geo_algo::prepare<PointGeoPrepared>(points);
+        QVERIFY(prepared.size() == points.size());
+        QVERIFY(prepared.front().point() == points.front());
+
+        bool valid = true;
+        for(size_t i = 1; i < points.size(); ++i){
+            const auto [range1, azimuth1] = geo_algo::geographic_inverse(points[0], points[i]);
+            const auto [range2, azimuth2] = geo_algo::geographic_inverse(prepared[0], prepared[i]);
+            valid &= algorithm::compare(range1, range2) && algorithm::compare(azimuth1, azimuth2);
+            const auto [spherical1, bearing1] = geo_algo::spherical_inverse(points[0], points[i]);
+            const auto [spherical2, bearing2] = geo_algo::spherical_inverse(prepared[0], prepared[i]);
+            valid &= algorithm::compare(spherical1, spherical2) && algorithm::compare(bearing1, bearing2);
+            valid &= (geo_algo::common_survey_comp(range1, azimuth1, prepared[0]).point()
+                      == geo_algo::common_survey_comp(range1, azimuth1, points[0]));
+        }
+        QVERIFY(valid);
+
+        dynamic_matrix<double> expected(points.size(), points.size());
+        dynamic_matrix<double> matrix(points.size(), points.size());
+        geo_algo::distance_matrix(points, expected);
+        geo_algo::distance_matrix(prepared, matrix, 2);
+        QVERIFY(matrix == expected);
+
+        //Кэш другого эллипсоида не используется
+        const point_geo2d_prepared<double, Angle, wgs84<double>> other(points[1]);
+        QVERIFY(algorithm::compare(std::get<0>(geo_algo::geographic_inverse(prepared[0], PointGeoPrepared(other.point()))),
+                                   std::get<0>(geo_algo::geographic_inverse(points[0], points[1]))));
+        QVERIFY(algorithm::compare(std::get<0>(geo_algo::geographic_inverse<decltype(other), algorithm::function_angle<double>, wgs84<double>>(
+                                       other, decltype(other)(points[0]))),
+                                   std::get<0>(geo_algo::geographic_inverse<PointGeo, algorithm::function_angle<double>, wgs84<double>>(
+                                       points[1], points[0]))));
+    }
+
+    {//local_frame
+        geo_algo::local_frame frame(PointGeo(0_deg, 0_deg));
+        auto point = frame.to_local<Point>(PointGeo(0_deg, 1_deg));
+        QVERIFY(point == Point(111313.821784, 0.));
+        QVERIFY(frame.to_geo(point) == PointGeo(0_deg, 1_deg));
+
+        geo_algo::local_frame moscow(PointGeo(55.75_deg, 37.6_deg));
+        for(const auto &item : {Point(10000., 0.), Point(-3000., 25000.), Point(-40000., -40000.)}){
+            QVERIFY(moscow.to_local<Point>(moscow.to_geo(item)) == item);
+        }
+        const auto &reference = moscow.reference();
+        auto enu = moscow.enu(geo_algo::ecef(reference.latitude(), reference.longitude(), 1500.));
+        QVERIFY(algorithm::compare(enu[0], 0.));
+        QVERIFY(algorithm::compare(enu[1], 0.));
+        QVERIFY(algorithm::compare(enu[2], 1500.));
+    }
+
+    {//convert(frame::LOCAL_TANGENT)
+        const PointGeo reference(55.75_deg, 37.6_deg);
+        const geo_algo::local_frame frame(reference);
+        auto point = geo_algo::convert<Point>(PointGeo(55.8_deg, 37.7_deg), reference, geo_algo::frame::LOCAL_TANGENT);
+        QVERIFY(point == frame.to_local<Point>(PointGeo(55.8_deg, 37.7_deg)));
+        QVERIFY(geo_algo::convert<PointGeo>(point, reference, geo_algo::frame::LOCAL_TANGENT) == PointGeo(55.8_deg, 37.7_deg));
+        QVERIFY(geo_algo::convert<Point>(PointGeo(55.8_deg, 37.7_deg), reference, geo_algo::frame::GEODESIC)
+                == geo_algo::convert<Point>(PointGeo(55.8_deg, 37.7_deg), reference));
+
+        auto points = std::vector{Point(0,0), Point(0,1000), Point(1000,1000), Point(1000,0)};
+        auto geo_points = geo_algo::convert<PointGeo>(points, frame);
+        QVERIFY(geo_points.front() == reference);
+        QVERIFY(geo_algo::convert<Point>(geo_points, frame) == points);
+    }
+}
+
+void Unit_Test::test_geo_index()
+{
+    using GeoIndex = geo_index_impl<PointGeo>;
+    {//cell
+        QVERIFY(GeoIndex::cell(PointGeo(0_deg, 0_deg), 1) == 3);
+        QVERIFY(GeoIndex::cell(PointGeo(-10_deg, -10_deg), 1) == 0);
+        QVERIFY(GeoIndex::cell(PointGeo(10_deg, 190_deg), 1) == GeoIndex::cell(PointGeo(10_deg, -170_deg), 1));
+        const auto key = GeoIndex::cell(PointGeo(55.75_deg, 37.6_deg));
+        for(unsigned level = 0; level < GeoIndex::bits; ++level){
+            QVERIFY(GeoIndex::cell(PointGeo(55.75_deg, 37.6_deg), level) == key >> (2 * (GeoIndex::bits - level)));
+        }
+    }
+
+    {//cover
+        auto ranges = GeoIndex::cover(geo_box<double>{(10_deg).radian(), (20_deg).radian(), (170_deg).radian(), (-170_deg).radian()});
+        QVERIFY(!ranges.empty() && (ranges.size() <= GeoIndex::max_cells));
+        QVERIFY(std::ranges::is_sorted(ranges));
+        auto contains = [&ranges](GeoIndex::key_type key){
+            return std::ranges::any_of(ranges, [key](const auto &range){
+                return (range.first <= key) && (key < range.second);
+            });
+        };
+        QVERIFY(contains(GeoIndex::cell(PointGeo(15_deg, 175_deg))));
+        QVERIFY(contains(GeoIndex::cell(PointGeo(15_deg, -175_deg))));
+
+        auto box = GeoIndex::bounding_box(CircleGeo(PointGeo(89.9_deg, 0_deg), 50'000.));
+        QVERIFY(algorithm::compare(box.north, algorithm::pi_on_2<double>));
+        QVERIFY(algorithm::compare(box.west, -algorithm::pi<double>) && algorithm::compare(box.east, algorithm::pi<double>));
+
+        box = GeoIndex::bounding_box(CircleGeo(PointGeo(0_deg, 179.9_deg), 50'000.));
+        QVERIFY(box.west > box.east);
+    }
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> latitude(-algorithm::pi_on_2<double>, algorithm::pi_on_2<double>);
+    std::uniform_real_distribution<double> longitude(-algorithm::pi<double>, algorithm::pi<double>);
+    std::uniform_real_distribution<double> offset(-0.02, 0.02);
+    std::vector<PointGeo> points;
+    for(int i = 0; i < 3000; ++i){
+        points.emplace_back(latitude(generator), longitude(generator));
+    }
+    //Сгущения у антимеридиана и полюса
+    for(int i = 0; i < 1000; ++i){
+        points.emplace_back(offset(generator), algorithm::pi<double> - std::abs(offset(generator)));
+        points.emplace_back(offset(generator), -algorithm::pi<double> + std::abs(offset(generator)));
+        points.emplace_back(algorithm::pi_on_2<double> - std::abs(offset(generator)), longitude(generator));
+    }
+    const GeoIndex index(points);
+    QVERIFY(index.size() == points.size());
+
+    auto brute = [&points](const PointGeo &center, double radius){
+        std::vector<size_t> temp;
+        for(size_t i = 0; i < points.size(); ++i){
+            if(std::get<0>(geo_algo::geographic_inverse(center, points[i])) < radius){
+                temp.push_back(i);
+            }
+        }
+        return temp;
+    };
+    auto sorted = [](std::vector<size_t> value){
+        std::ranges::sort(value);
+        return value;
+    };
+
+    {//range(circle)
+        for(const auto &center : {PointGeo(0_deg, 180_deg), PointGeo(0.5_deg, -179.9_deg), PointGeo(89.5_deg, 10_deg),
+                                   PointGeo(30_deg, 40_deg)}){
+            for(const auto radius : {50'000., 200'000., 1'000'000.}){
+                QVERIFY(sorted(index.range(CircleGeo(center, radius))) == brute(center, radius));
+            }
+        }
+        QVERIFY(!index.range(CircleGeo(PointGeo(0_deg, 180_deg), 100'000.)).empty());
+        QVERIFY(!index.range(CircleGeo(PointGeo(90_deg, 0_deg), 100'000.)).empty());
+    }
+
+    {//range(box)
+        const geo_box<double> box{(-0.5_deg).radian(), (0.5_deg).radian(), (179_deg).radian(), (-179_deg).radian()};
+        std::vector<size_t> expected;
+        for(size_t i = 0; i < points.size(); ++i){
+            const auto lat = points[i].latitude();
+            const auto lon = points[i].longitude();
+            if((box.south <= lat) && (lat <= box.north) && ((box.west <= lon) || (lon <= box.east))){
+                expected.push_back(i);
+            }
+        }
+        QVERIFY(!expected.empty());
+        QVERIFY(sorted(index.range(box)) == expected);
+    }
+
+    {//nearest
+        for(const auto &center : {PointGeo(0_deg, 180_deg), PointGeo(89.9_deg, 0_deg), PointGeo(-40_deg, 20_deg)}){
+            auto result = index.nearest(center, 5);
+            QVERIFY(result.size() == 5);
+            std::vector<std::pair<double, size_t>> expected;
+            for(size_t i = 0; i < points.size(); ++i){
+                expected.emplace_back(std::get<0>(geo_algo::geographic_inverse(center, points[i])), i);
+            }
+            std::ranges::sort(expected);
+            for(size_t i = 0; i < result.size(); ++i){
+                QVERIFY(result[i].first == expected[i].second);
+                QVERIFY(algorithm::compare(result[i].second, expected[i].first));
+            }
+        }
+        QVERIFY(GeoIndex().nearest(PointGeo(0_deg, 0_deg), 3).empty());
+    }
+}
+
+void Unit_Test::test_projection()
+{
+    using Wgs84 = wgs84<double>;
+    using Func = algorithm::function_angle<double>;
+    {//kruger_series
+        using series = projection_algo::kruger_series<double, Wgs84>;
+        static_assert(algorithm::compare_common(series::rectifying_radius, 6367449.1458, 1e-3));
+        static_assert(algorithm::compare_common(series::alpha[0], 8.3773182e-4, 1e-12));
+    }
+
+    {//transverse_mercator
+        //Масштаб 1 без сдвигов: northing на осевом меридиане равен длине дуги меридиана
+        const projection_algo::transverse_mercator<double, Func, Wgs84> projection(0., 1., 0., 0.);
+        const auto [easting, northing] = projection.forward((45_deg).radian(), 0.);
+        QVERIFY(algorithm::compare(easting, 0.));
+        QVERIFY(algorithm::compare_common(northing, 4984944.378, 0.001));
+
+        const auto point = projection.forward<Point>(PointGeo(0_deg, 0_deg));
+        QVERIFY(point == Point(0., 0.));
+
+        //Обратное преобразование восстанавливает точку и в 30 градусах от осевого меридиана
+        std::mt19937 generator(5);
+        std::uniform_real_distribution<double> latitude(-1.4, 1.4);
+        std::uniform_real_distribution<double> longitude(-0.5, 0.5);
+        std::vector<PointGeo> points;
+        for(int i = 0; i < 1000; ++i){
+            points.emplace_back(latitude(generator), longitude(generator));
+        }
+        const auto planar = projection.forward<Point>(points);
+        QVERIFY(projection.inverse<PointGeo>(planar) == points);
+
+        std::vector<double> lat, lon;
+        for(const auto &item : points){
+            lat.push_back(item.latitude());
+            lon.push_back(item.longitude());
+        }
+        std::vector<double> x(points.size()), y(points.size());
+        projection.forward(std::span<const double>(lat), std::span<const double>(lon), std::span(x), std::span(y));
+        bool valid = true;
+        for(size_t i = 0; i < points.size(); ++i){
+            valid &= (Point(x[i], y[i]) == planar[i]);
+        }
+        QVERIFY(valid);
+        std::vector<double> lat_back(points.size()), lon_back(points.size());
+        projection.inverse(std::span<const double>(x), std::span<const double>(y), std::span(lat_back), std::span(lon_back));
+        for(size_t i = 0; i < points.size(); ++i){
+            valid &= (PointGeo(lat_back[i], lon_back[i]) == points[i]);
+        }
+        QVERIFY(valid);
+        bool thrown = false;
+        try{
+            std::vector<double> small(10);
+            projection.forward(std::span<const double>(lat), std::span<const double>(lon), std::span(small), std::span(y));
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//utm
+        QVERIFY(projection_algo::utm_zone((48.85826_deg).radian(), (2.2945_deg).radian()) == 31);
+        QVERIFY(projection_algo::utm_zone((60_deg).radian(), (5_deg).radian()) == 32);
+        QVERIFY(projection_algo::utm_zone((78_deg).radian(), (15_deg).radian()) == 33);
+        QVERIFY(projection_algo::utm_zone((-33_deg).radian(), (-70.6_deg).radian()) == 19);
+        QVERIFY(projection_algo::utm_zone(0., algorithm::pi<double>) == 1);
+        bool thrown = false;
+        try{
+            projection_algo::utm_zone(1.5, 0.);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+
+        //Независимый расчёт по формулам Снайдера
+        const PointGeo eiffel(48.85826_deg, 2.2945_deg);
+        const auto utm = projection_algo::to_utm<PointGeo, Func, Wgs84>(eiffel);
+        QVERIFY((utm.zone == 31) && utm.north);
+        QVERIFY(algorithm::compare_common(utm.easting, 448251.8571, 0.001));
+        QVERIFY(algorithm::compare_common(utm.northing, 5411939.3477, 0.001));
+        QVERIFY((projection_algo::from_utm<PointGeo, Func, Wgs84>(utm) == eiffel));
+        //Без явного эллипсоида - WGS84
+        const auto default_utm = projection_algo::to_utm(eiffel);
+        QVERIFY(algorithm::compare(default_utm.easting, utm.easting) && algorithm::compare(default_utm.northing, utm.northing));
+        QVERIFY(algorithm::compare(projection_algo::utm<double>(31).forward(eiffel.latitude(), eiffel.longitude()).second, utm.northing));
+
+        const PointGeo santiago(-33.45_deg, -70.66_deg);
+        const auto south = projection_algo::to_utm(santiago);
+        QVERIFY(!south.north && (south.northing > 6'000'000.) && (south.northing < 10'000'000.));
+        QVERIFY(projection_algo::from_utm<PointGeo>(south) == santiago);
+
+        //Точки по обе стороны границы зон 36/37 проецируются в общую зону
+        const std::vector<PointGeo> edge{PointGeo(55_deg, 35.5_deg), PointGeo(55_deg, 36.5_deg), PointGeo(56_deg, 37.6_deg)};
+        const auto zone = projection_algo::utm_zone(edge);
+        QVERIFY(zone == 37);
+        const auto west = projection_algo::to_utm(edge[0], zone);
+        QVERIFY((west.zone == 37) && (west.easting < projection_algo::to_utm(PointGeo(55_deg, 36_deg), 37).easting));
+        QVERIFY(projection_algo::from_utm<PointGeo>(west) == edge[0]);
+        QVERIFY(projection_algo::utm_zone(std::vector{PointGeo(0_deg, 179_deg), PointGeo(0_deg, -178_deg)}) == 1);
+    }
+
+    {//web_mercator
+        const projection_algo::web_mercator<double> world(0);
+        QVERIFY(world.forward<Point>(PointGeo(0_deg, 0_deg)) == Point(128., 128.));
+        QVERIFY(world.forward<Point>(PointGeo(90_deg, -180_deg)) == Point(0., 0.));
+        QVERIFY((world.tile(PointGeo(-89_deg, 179.9_deg)) == projection_algo::tile_index{0, 0}));
+
+        const projection_algo::web_mercator<double> mercator(10);
+        const PointGeo moscow(55.7558_deg, 37.6173_deg);
+        QVERIFY(mercator.forward<Point>(moscow) == Point(158464.08192, 81946.888056));
+        QVERIFY(mercator.inverse<PointGeo>(mercator.forward<Point>(moscow)) == moscow);
+        const auto tile = mercator.tile(moscow);
+        QVERIFY((tile == projection_algo::tile_index{619, 320}));
+        const auto box = mercator.bounds(tile);
+        QVERIFY((box.south < moscow.latitude()) && (moscow.latitude() < box.north));
+        QVERIFY((box.west < moscow.longitude()) && (moscow.longitude() < box.east));
+        QVERIFY(algorithm::compare(box.east - box.west, algorithm::pi_in_2<double> / 1024));
+
+        bool thrown = false;
+        try{
+            projection_algo::web_mercator<double> invalid(31);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+
+        std::mt19937 generator(3);
+        std::uniform_real_distribution<double> latitude(0.95, 0.99);
+        std::uniform_real_distribution<double> longitude(0.64, 0.68);
+        std::vector<PointGeo> points;
+        for(int i = 0; i < 5000; ++i){
+            points.emplace_back(latitude(generator), longitude(generator));
+        }
+        const projection_algo::web_mercator<double> city(13);
+        const auto buckets = city.bucket(points);
+        QVERIFY(buckets.order().size() == points.size());
+        bool valid = true;
+        size_t total{};
+        for(size_t i = 0; i < buckets.size(); ++i){
+            const auto indices = buckets.points(i);
+            total += indices.size();
+            valid &= std::ranges::is_sorted(indices);
+            for(const auto index : indices){
+                valid &= (city.tile(points[index]) == buckets.tile(i));
+            }
+            if(i > 0){
+                const auto prior = buckets.tile(i - 1);
+                const auto current = buckets.tile(i);
+                valid &= std::tie(prior.y, prior.x) < std::tie(current.y, current.x);
+            }
+        }
+        QVERIFY(valid);
+        QVERIFY(total == points.size());
+
+        std::vector<double> x(points.size()), y(points.size());
+        std::vector<double> lat, lon;
+        for(const auto &point : points){
+            lat.push_back(point.latitude());
+            lon.push_back(point.longitude());
+        }
+        city.forward(std::span<const double>(lat), std::span<const double>(lon), std::span(x), std::span(y));
+        QVERIFY(city.bucket(std::span<const double>(x), std::span<const double>(y)).order() == buckets.order());
+        city.inverse(std::span<const double>(x), std::span<const double>(y), std::span(lat), std::span(lon));
+        QVERIFY(PointGeo(lat[7], lon[7]) == points[7]);
+    }
 }
 
 void Unit_Test::test_approximation()
@@ -1620,6 +2468,53 @@ void Unit_Test::test_approximation()
         // 48.90738003669028 10.395584540887972
         // 49.72609476841367 5.226423163382684
     }
+
+    {//sample_segment
+        auto points = approximation_algo::sample_segment(Point(0,0), Point(4,3), 5);
+        QVERIFY(std::ranges::distance(points) == 6);
+        QVERIFY(*points.begin() == Point(0, 0));
+        QVERIFY(points[1] == Point(0.8, 0.6));
+        QVERIFY(points[5] == Point(4, 3));
+        QVERIFY(std::ranges::equal(points, approximation_algo::splitting_evenly(Point(0,0), Point(4,3), 5)));
+
+        auto line = LineSection(Point(1,1), Point(5,4));
+        auto far = approximation_algo::sample_segment(view_line(line), 5) | std::views::filter([](const auto &point){
+            return point.x() > 3;
+        });
+        QVERIFY(std::ranges::distance(far) == 3);
+        QVERIFY(*far.begin() == Point(3.4, 2.8));
+    }
+
+    {//sample_segment_step
+        auto points = approximation_algo::sample_segment_step(Point(0,0), Point(40,30), 5.);
+        QVERIFY(std::ranges::distance(points) == 11);
+        QVERIFY(points[1] == Point(4, 3));
+        QVERIFY(points[10] == Point(40, 30));
+        QVERIFY(std::ranges::distance(approximation_algo::sample_segment_step(Point(0,0), Point(40,30), 6.)) == 9);
+        QVERIFY(std::ranges::empty(approximation_algo::sample_segment_step(Point(0,0), Point(40,30), 0.)));
+    }
+
+    {//sample_arc
+        auto arc = Arc(Point(0,0), 10, 0, 90_deg);
+        auto points = approximation_algo::sample_arc(arc, 2);
+        QVERIFY(std::ranges::distance(points) == 3);
+        QVERIFY(points[0] == Point(0, 10));
+        QVERIFY(points[1] == Point(7.071068, 7.071068));
+        QVERIFY(points[2] == Point(10, 0));
+        QVERIFY(std::ranges::equal(approximation_algo::sample_arc(arc, 5, algorithm::direct::LEFT),
+                                   approximation_algo::splitting_evenly(arc, 5, algorithm::direct::LEFT)));
+
+        auto step = approximation_algo::sample_arc_step(Arc(Point(0,0), 50, 0, 90_deg), 5.);
+        QVERIFY(std::ranges::distance(step) == 16);
+        QVERIFY(step[1] == Point(4.991671, 49.750208));
+    }
+
+    {//sample_circle
+        auto points = approximation_algo::sample_circle(Circle(Point(0,0), 10), 4);
+        QVERIFY(std::ranges::distance(points) == 5);
+        QVERIFY(points[1] == Point(10, 0));
+        QVERIFY(points[0] == points[4]);
+    }
 }
 
 void Unit_Test::test_matrix()
@@ -2054,6 +2949,40 @@ void Unit_Test::test_matrix()
             auto iden = matrix_algo::identity_matrix<matrix,double,3>();
             QVERIFY(inv.value() * m == iden);
         }
+        {
+            constexpr matrix<double, 4, 4> m{1,2,3,4,
+                                             5,6,7,8,
+                                             1,4,5,3,
+                                             13,56,5,16};
+            static_assert(m.determinant() == 1624.);
+            constexpr auto inv = matrix_algo::inverse_matrix(m);
+            static_assert(inv.has_value());
+            QVERIFY(inv.value() * m == (matrix_algo::identity_matrix<matrix,double,4>()));
+            QVERIFY(matrix_algo::adjugate(m) == 1624. * inv.value());
+            QVERIFY(matrix_algo::matrix_algebraic_additions(m) == matrix_algo::adjugate(m).transposed());
+            QVERIFY(!matrix_algo::inverse_matrix(matrix<double, 4, 4>{1,2,3,4, 2,4,6,8, 0,1,0,1, 1,0,1,0}).has_value());
+        }
+        {
+            constexpr matrix<double, 2, 2> m{4,7,
+                                             2,6};
+            static_assert(matrix_algo::inverse_matrix(m).value() == matrix<double, 2, 2>{0.6,-0.7,-0.2,0.4});
+            constexpr matrix<double, 3, 3> m3{2,0,1,
+                                              1,3,2,
+                                              1,1,2};
+            static_assert(m3.determinant() == 6.);
+            static_assert(matrix_algo::adjugate(m3) == matrix<double, 3, 3>{4,1,-3,0,3,-3,-2,-2,6});
+        }
+        {
+            //Общий путь N > 4: знаки алгебраических дополнений в шахматном порядке
+            matrix<double, 6, 6> m{2,1,0,0,0,1,
+                                   1,3,1,0,0,0,
+                                   0,1,4,1,0,0,
+                                   0,0,1,5,1,0,
+                                   0,0,0,1,6,1,
+                                   1,0,0,0,1,7};
+            auto inv = matrix_algo::inverse_matrix(m);
+            QVERIFY(inv.value() * m == (matrix_algo::identity_matrix<matrix,double,6>()));
+        }
     }
 
     {//rang
@@ -2100,6 +3029,986 @@ void Unit_Test::test_matrix()
             QVERIFY(matrix_algo::rang(m) == 3);
         }
     }
+
+    {//dynamic_matrix
+        dynamic_matrix<double> m(2, 3, 1.);
+        QVERIFY((m.rows() == 2) && (m.columns() == 3) && (m.stride() == 3));
+        m.value(1, 2) = 5.;
+        QVERIFY(m.data()[5] == 5.);
+        QVERIFY(m.row(1).size() == 3);
+        QVERIFY(m.row(1)[2] == 5.);
+        QVERIFY(m != dynamic_matrix<double>(2, 3, 1.));
+        QVERIFY(m != dynamic_matrix<double>(3, 2, 1.));
+        m.resize(3, 2);
+        QVERIFY(m == dynamic_matrix<double>(3, 2));
+        bool thrown = false;
+        try{
+            m.value(3, 0);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//matrix_batch
+        std::mt19937 generator(9);
+        std::uniform_real_distribution<double> random(-1., 1.);
+        std::vector<matrix<double, 6, 6>> systems(13);
+        std::vector<matrix<double, 6, 1>> rhs(13);
+        for(auto &m : systems){
+            std::ranges::generate(m, [&]{ return random(generator); });
+        }
+        for(auto &r : rhs){
+            std::ranges::generate(r, [&]{ return random(generator); });
+        }
+        //Вырожденная система: две одинаковые строки
+        systems[5].copy_row(1, 4);
+
+        matrix_batch<double, 6, 6> batch{std::span<const matrix<double, 6, 6>>(systems)};
+        QVERIFY((batch.size() == 13) && (batch.blocks() == 2));
+        QVERIFY(batch.store() == systems);
+        QVERIFY(algorithm::compare(batch.value(12, 3, 4), systems[12].value(3, 4)));
+
+        matrix_batch<double, 6, 1> right{std::span<const matrix<double, 6, 1>>(rhs)};
+        matrix_batch<double, 6, 1> solution;
+        const auto valid = matrix_algo::solve(batch, right, solution);
+        QVERIFY(!valid[5]);
+        bool same = true;
+        for(size_t k = 0; k < systems.size(); ++k){
+            if(k != 5){
+                same &= valid[k] && (systems[k] * solution.get(k) == rhs[k]);
+            }
+        }
+        QVERIFY(same);
+
+        matrix_batch<double, 6, 6> inverse;
+        const auto invertible = matrix_algo::inverse_matrix(batch, inverse);
+        QVERIFY(!invertible[5] && invertible[12]);
+        QVERIFY(inverse.get(12) * systems[12] == (matrix_algo::identity_matrix<matrix,double,6>()));
+
+        matrix_batch<double, 6, 6> product;
+        matrix_algo::mul(batch, inverse, product);
+        QVERIFY(product.get(0) == systems[0] * inverse.get(0));
+
+        const auto det = matrix_algo::determinant(batch);
+        bool equal = true;
+        for(size_t k = 0; k < systems.size(); ++k){
+            equal &= algorithm::compare(det[k], systems[k].determinant());
+        }
+        QVERIFY(equal);
+        QVERIFY(det[5] == 0.);
+
+        std::vector<matrix<double, 3, 3>> small{{2,0,1, 1,3,2, 1,1,2}, {4,7,0, 2,6,0, 0,0,1}};
+        matrix_batch<double, 3, 3, 4> batch3{std::span<const matrix<double, 3, 3>>(small)};
+        matrix_batch<double, 3, 3, 4> inverse3;
+        matrix_algo::inverse_matrix(batch3, inverse3);
+        QVERIFY(inverse3.get(0) == matrix_algo::inverse_matrix(small[0]).value());
+        QVERIFY(inverse3.get(1) == matrix_algo::inverse_matrix(small[1]).value());
+        QVERIFY(algorithm::compare(matrix_algo::determinant(batch3)[0], 6.));
+    }
+}
+
+void Unit_Test::test_affine()
+{
+    {//affine_impl<2>
+        const auto rotation = Affine2d::rotation(0.3, Point(2., 1.));
+        QVERIFY(rotation.apply(Point(5., 7.)) == point_algo::rotate(Point(5., 7.), 0.3, Point(2., 1.)));
+        QVERIFY(Affine2d::rotation(90_deg).apply(Point(0., 1.)) == Point(1., 0.));
+        QVERIFY(Affine2d::translation(1., 2.).then(Affine2d::scale(2., 3.)).apply(Point(1., 1.)) == Point(4., 9.));
+        QVERIFY((Affine2d::scale(2., 3.) * Affine2d::translation(1., 2.)) == Affine2d::translation(1., 2.).then(Affine2d::scale(2., 3.)));
+
+        const auto transform = Affine2d::translation(3., -2.) * Affine2d::rotation(0.7)
+                             * Affine2d(Affine2d::matrix_type{2., 0.5, 0., 0., -1.5, 0., 0., 0., 1.});
+        const auto parts = transform.decompose();
+        QVERIFY(algorithm::compare(parts.dx, 3.) && algorithm::compare(parts.dy, -2.));
+        QVERIFY(algorithm::compare(parts.angle, 0.7));
+        QVERIFY(algorithm::compare(parts.scale_x, 2.) && algorithm::compare(parts.scale_y, -1.5) && algorithm::compare(parts.shear, 0.5));
+        QVERIFY((transform.inverse().value() * transform) == Affine2d());
+        QVERIFY(!Affine2d::scale(1., 0.).inverse().has_value());
+        QVERIFY(!transform.is_similarity());
+        QVERIFY(Affine2d::rotation(1.).then(Affine2d::scale(-2., 2.)).is_similarity());
+
+        bool thrown = false;
+        try{
+            Affine2d(Affine2d::matrix_type{1., 0., 0., 0., 1., 0., 1., 0., 1.});
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//apply
+        const auto chain = Affine2d::rotation(0.3, Point(3., 4.)).then(Affine2d::translation(5., -2.));
+        std::vector<Point> points{Point(0., 0.), Point(10., -3.), Point(-7., 2.)};
+        std::vector<Point> expected;
+        for(const auto &point : points){
+            const auto temp = point_algo::rotate(point, 0.3, Point(3., 4.));
+            expected.emplace_back(temp.x() + 5., temp.y() - 2.);
+        }
+        QVERIFY(chain.apply(points) == expected);
+
+        PointCloud cloud(points);
+        chain.apply(cloud);
+        QVERIFY(cloud.point<Point>(1) == expected[1]);
+
+        auto span_points = points;
+        chain.apply(std::span(span_points));
+        QVERIFY(span_points == expected);
+
+        const RegularPolygon polygon(Point(0., 0.), 2., 6);
+        const auto moved = Affine2d::translation(1., 1.).apply(polygon);
+        QVERIFY(moved.front() == Point(polygon.get_points().front().x() + 1., polygon.get_points().front().y() + 1.));
+        const auto rotated = Affine2d::rotation(0.5).apply(polygon);
+        QVERIFY((rotated.size() == 6) && (rotated.front() == Point(2. * std::sin(0.5), 2. * std::cos(0.5))));
+        QVERIFY(rotated[2] == Affine2d::rotation(0.5).apply(polygon.get_points()[2]));
+        //Неподобное преобразование не бросает исключение
+        const auto stretched = Affine2d::scale(2., 1.).apply(polygon);
+        QVERIFY(stretched[1] == Point(2. * polygon.get_points()[1].x(), polygon.get_points()[1].y()));
+
+        const auto similarity = Affine2d::translation(1., 1.) * Affine2d::rotation(0.5) * Affine2d::scale(2., 2.);
+        const auto circle = similarity.apply(Circle(Point(1., 0.), 1.5));
+        QVERIFY((circle.center() == similarity.apply(Point(1., 0.))) && algorithm::compare(circle.radius(), 3.));
+        const auto arc = similarity.apply(Arc(Point(0., 0.), 1., 0.1, 1.));
+        QVERIFY((arc.center() == Point(1., 1.)) && algorithm::compare(arc.radius(), 2.));
+        QVERIFY(algorithm::compare(arc.start(), 0.6) && algorithm::compare(arc.stop(), 1.5));
+        //Отражение меняет направление обхода дуги
+        const auto mirrored = Affine2d::scale(-1., 1.).apply(Arc(Point(0., 0.), 1., 0.1, 1.));
+        QVERIFY(algorithm::compare(mirrored.start(), algorithm::pi_in_2<double> - 1.));
+        QVERIFY(algorithm::compare(mirrored.stop(), algorithm::pi_in_2<double> - 0.1));
+
+        bool thrown = false;
+        try{
+            Affine2d::scale(1., 2.).apply(Circle(Point(0., 0.), 1.));
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//affine_impl<3>
+        const auto mount = Affine3d::translation(1., 2., 3.) * Affine3d::rotation_h(0.4) * Affine3d::rotation_x(0.2)
+                         * Affine3d::rotation_y(-0.3);
+        const auto transform = mount * Affine3d(Affine3d::matrix_type{2., 0.1, 0.2, 0., 0., 3., 0.3, 0., 0., 0., -4., 0., 0., 0., 0., 1.});
+        const auto parts = transform.decompose();
+        QVERIFY(algorithm::compare(parts.scale[0], 2.) && algorithm::compare(parts.scale[1], 3.) && algorithm::compare(parts.scale[2], -4.));
+        QVERIFY(algorithm::compare(parts.shear[0], 0.1) && algorithm::compare(parts.shear[2], 0.3));
+        QVERIFY(algorithm::compare(parts.rotation.determinant(), 1.));
+        QVERIFY(mount.is_similarity() && !transform.is_similarity());
+
+        QVERIFY(Affine3d::rotation_h(algorithm::pi_on_2<double>).apply(Point3d(0., 1., 5.)) == Point3d(1., 0., 5.));
+        QVERIFY(Affine3d::rotation_x(algorithm::pi_on_2<double>).apply(Point3d(0., 1., 0.)) == Point3d(0., 0., 1.));
+        QVERIFY(Affine3d::rotation_y(algorithm::pi_on_2<double>).apply(Point3d(1., 0., 0.)) == Point3d(0., 0., 1.));
+        const auto inverse = transform.inverse().value();
+        QVERIFY(inverse.apply(transform.apply(Point3d(4., -5., 6.))) == Point3d(4., -5., 6.));
+    }
+}
+
+void Unit_Test::test_quaternion()
+{
+    {//Элементарные повороты и углы Эйлера
+        const Point3d point(3., -4., 5.);
+        QVERIFY(Quaternion::heading(0.7).apply(point) == Affine3d::rotation_h(0.7).apply(point));
+        QVERIFY(Quaternion::pitch(-0.3).apply(point) == Affine3d::rotation_x(-0.3).apply(point));
+        QVERIFY(Quaternion::roll(1.1).apply(point) == Affine3d::rotation_y(1.1).apply(point));
+
+        const auto q = Quaternion::euler(0.7, -0.3, 1.1);
+        const auto transform = Affine3d::rotation_h(0.7) * Affine3d::rotation_x(-0.3) * Affine3d::rotation_y(1.1);
+        QVERIFY(q.apply(point) == transform.apply(point));
+        QVERIFY(q == Quaternion::heading(0.7) * Quaternion::pitch(-0.3) * Quaternion::roll(1.1));
+        QVERIFY(Quaternion::roll(1.1).then(Quaternion::pitch(-0.3)).then(Quaternion::heading(0.7)) == q);
+        QVERIFY(algorithm::compare(q.norm(), 1.));
+
+        const auto angles = q.to_euler();
+        QVERIFY(algorithm::compare(angles.heading, 0.7) && algorithm::compare(angles.pitch, -0.3) && algorithm::compare(angles.roll, 1.1));
+        //При тангаже 90 градусов курс и крен складываются
+        const auto gimbal = Quaternion::euler(0.5, algorithm::pi_on_2<double>, 0.3).to_euler();
+        QVERIFY(algorithm::compare(gimbal.heading, 0.8) && algorithm::compare(gimbal.roll, 0.));
+    }
+
+    {//Матрица, ось и угол, обращение
+        const auto q = Quaternion::euler(3., 0.2, -2.9);
+        QVERIFY(Quaternion::from_matrix(q.to_matrix()) == q);
+        QVERIFY(q.to_matrix() * q.conjugate().to_matrix() == (matrix_algo::identity_matrix<matrix, double, 3>()));
+        QVERIFY((q * q.inverse()) == Quaternion());
+        QVERIFY(q.inverse().apply(q.apply(Point3d(1., 2., 3.))) == Point3d(1., 2., 3.));
+
+        const auto axis = Quaternion::axis_angle(Point3d(0., 0., 2.), 0.4);
+        QVERIFY(axis.apply(Point3d(1., 0., 0.)) == Point3d(std::cos(0.4), std::sin(0.4), 0.));
+        QVERIFY(algorithm::compare(axis.angle(), 0.4));
+        QVERIFY(axis.axis<Point3d>() == Point3d(0., 0., 1.));
+
+        bool thrown = false;
+        try{
+            Quaternion::axis_angle(Point3d(0., 0., 0.), 1.);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//slerp
+        const auto q = quaternion_algo::slerp(Quaternion::heading(0.2), Quaternion::heading(1.), 0.25);
+        QVERIFY(algorithm::compare(q.to_euler().heading, 0.4));
+        QVERIFY(algorithm::compare(quaternion_algo::angle(Quaternion::heading(0.2), Quaternion::heading(1.)), 0.8));
+        //Кратчайшая дуга: -q задаёт тот же поворот
+        const auto q2 = Quaternion::heading(1.);
+        const auto minus = quaternion_algo::slerp(Quaternion::heading(0.2), Quaternion(-q2.w(), -q2.x(), -q2.y(), -q2.z()), 0.5);
+        QVERIFY(algorithm::compare(minus.to_euler().heading, 0.6));
+        QVERIFY(quaternion_algo::slerp(q2, q2, 0.3) == q2);
+    }
+
+    {//Пакетный поворот
+        const auto q = Quaternion::euler(0.7, -0.3, 1.1);
+        std::vector<Point3d> points{Point3d(0., 0., 0.), Point3d(10., -3., 2.), Point3d(-7., 2., -1.)};
+        std::vector<Point3d> expected;
+        for(const auto &point : points){
+            expected.push_back(q.apply(point));
+        }
+        QVERIFY(q.apply(points) == expected);
+
+        PointCloud3d cloud(points);
+        q.apply(cloud);
+        QVERIFY(cloud.point<Point3d>(1) == expected[1]);
+        QVERIFY(algorithm::compare(cloud.h(2), expected[2].h()));
+
+        const auto transform = Affine3d::translation(1., 2., 3.);
+        transform.apply(cloud);
+        QVERIFY(cloud.point<Point3d>(1) == Point3d(expected[1].x() + 1., expected[1].y() + 2., expected[1].h() + 3.));
+    }
+}
+
+void Unit_Test::test_eigen()
+{
+    //Невязки A * V - V * L и V^T * V - I
+    auto residual = []<size_t N>(const matrix<double, N, N> &m, const eigen_decomposition<double, N> &e){
+        double error = 0.;
+        for(size_t i = 0; i < N; ++i){
+            for(size_t j = 0; j < N; ++j){
+                double av = 0.;
+                double vv = 0.;
+                for(size_t k = 0; k < N; ++k){
+                    av += m.value(i, k) * e.vectors.value(k, j);
+                    vv += e.vectors.value(k, i) * e.vectors.value(k, j);
+                }
+                error = std::max({error, std::abs(av - e.vectors.value(i, j) * e.values.get(j)), std::abs(vv - (i == j ? 1. : 0.))});
+            }
+        }
+        return error;
+    };
+
+    {//2x2
+        const matrix<double, 2, 2> m{2.5, 1.5,
+                                     1.5, 2.5};
+        const auto e = matrix_algo::eigen_symmetric(m);
+        QVERIFY((e.values == vector<double, 2>{4., 1.}));
+        QVERIFY(algorithm::compare(std::abs(e.vectors.value(0, 0)), std::sqrt(0.5)));
+        QVERIFY(algorithm::compare(e.vectors.value(0, 0), e.vectors.value(1, 0)));
+        QVERIFY(residual(m, e) < 1e-12);
+        QVERIFY((matrix_algo::eigen_values(m) == vector<double, 2>{4., 1.}));
+        const matrix<double, 2, 2> negative{1., -2., -2., -3.};
+        QVERIFY(residual(negative, matrix_algo::eigen_symmetric(negative)) < 1e-12);
+        const matrix<double, 2, 2> scalar{2., 0., 0., 2.};
+        QVERIFY(residual(scalar, matrix_algo::eigen_symmetric(scalar)) < 1e-12);
+    }
+
+    {//3x3
+        const auto rotation = Quaternion::euler(0.7, -0.3, 1.1).to_matrix();
+        const matrix<double, 3, 3> diagonal{5., 0., 0.,
+                                            0., -2., 0.,
+                                            0., 0., 3.};
+        const auto m = rotation * diagonal * matrix_algo::transposed(rotation);
+        const auto e = matrix_algo::eigen_symmetric(m);
+        QVERIFY((e.values == vector<double, 3>{5., 3., -2.}));
+        QVERIFY(residual(m, e) < 1e-12);
+        //Первый собственный вектор - первый столбец поворота (с точностью до знака)
+        QVERIFY(algorithm::compare(std::abs(e.vectors.value(0, 0) * rotation.value(0, 0) + e.vectors.value(1, 0) * rotation.value(1, 0)
+                                            + e.vectors.value(2, 0) * rotation.value(2, 0)), 1.));
+        //Кратные собственные числа
+        const matrix<double, 3, 3> repeated_diagonal{4., 0., 0.,
+                                                     0., 4., 0.,
+                                                     0., 0., 1.};
+        const auto repeated = rotation * repeated_diagonal * matrix_algo::transposed(rotation);
+        const auto r = matrix_algo::eigen_symmetric(repeated);
+        QVERIFY((r.values == vector<double, 3>{4., 4., 1.}));
+        QVERIFY(residual(repeated, r) < 1e-12);
+        const matrix<double, 3, 3> zero;
+        QVERIFY(residual(zero, matrix_algo::eigen_symmetric(zero)) < 1e-12);
+
+        const auto jacobi = matrix_algo::jacobi_eigen(m);
+        QVERIFY(jacobi.values == e.values);
+        QVERIFY(residual(m, jacobi) < 1e-12);
+    }
+
+    {//Якоби для больших матриц
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<double> distribution(-10., 10.);
+        for(int test = 0; test < 20; ++test){
+            matrix<double, 6, 6> m;
+            for(size_t i = 0; i < 6; ++i){
+                for(size_t j = i; j < 6; ++j){
+                    m.value(i, j) = m.value(j, i) = distribution(generator);
+                }
+            }
+            const auto e = matrix_algo::eigen_symmetric(m);
+            QVERIFY(residual(m, e) < 1e-11);
+            QVERIFY(std::ranges::is_sorted(e.values, std::greater{}));
+        }
+    }
+
+    {//Эллипс ошибок
+        const auto ellipse = matrix_algo::covariance_ellipse(matrix<double, 2, 2>{4., 0., 0., 1.}, 2.);
+        QVERIFY(algorithm::compare(ellipse.semi_major, 4.) && algorithm::compare(ellipse.semi_minor, 2.));
+        QVERIFY(algorithm::compare(ellipse.angle, algorithm::pi_on_2<double>));
+        QVERIFY(algorithm::compare(matrix_algo::covariance_ellipse(matrix<double, 2, 2>{1., 0., 0., 4.}).angle, 0.));
+        QVERIFY(algorithm::compare(matrix_algo::covariance_ellipse(matrix<double, 2, 2>{2.5, 1.5, 1.5, 2.5}).angle, algorithm::pi_on_4<double>));
+        QVERIFY(algorithm::compare(matrix_algo::covariance_ellipse(matrix<double, 2, 2>{2.5, -1.5, -1.5, 2.5}).angle, 3. * algorithm::pi_on_4<double>));
+
+        const std::vector<double> xx{4., 1., 2.5, 2.5};
+        const std::vector<double> xy{0., 0., 1.5, -1.5};
+        const std::vector<double> yy{1., 4., 2.5, 2.5};
+        std::vector<error_ellipse<double>> ellipses(xx.size());
+        matrix_algo::covariance_ellipse<double>(xx, xy, yy, std::span(ellipses), 2.);
+        for(size_t i = 0; i < xx.size(); ++i){
+            const auto single = matrix_algo::covariance_ellipse(matrix<double, 2, 2>{xx[i], xy[i], xy[i], yy[i]}, 2.);
+            QVERIFY(algorithm::compare(ellipses[i].semi_major, single.semi_major) && algorithm::compare(ellipses[i].angle, single.angle));
+        }
+
+        bool thrown = false;
+        try{
+            matrix_algo::covariance_ellipse<double>(xx, xy, std::span<const double>(yy).first(2), std::span(ellipses));
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//Главные оси облака точек и пакетное разложение
+        std::vector<Point> points;
+        for(int i = -10; i <= 10; ++i){
+            points.emplace_back(1. + 0.6 * i + 0.01 * (i % 3), 2. + 0.8 * i - 0.01 * (i % 2));
+        }
+        const auto [center, axes] = matrix_algo::principal_axes(points);
+        QVERIFY(algorithm::compare_common(center.x(), 1., 0.01) && algorithm::compare_common(center.y(), 2., 0.01));
+        QVERIFY(algorithm::compare_common(std::abs(axes.vectors.value(0, 0)), 0.6, 0.01));
+        QVERIFY(algorithm::compare_common(std::abs(axes.vectors.value(1, 0)), 0.8, 0.01));
+        QVERIFY(axes.values.get(1) < 1e-3 * axes.values.get(0));
+
+        std::vector<Point3d> points3d{Point3d(1., 0., 0.), Point3d(-1., 0., 0.), Point3d(0., 2., 0.), Point3d(0., -2., 0.),
+                                      Point3d(0., 0., 3.), Point3d(0., 0., -3.)};
+        const auto [center3d, axes3d] = matrix_algo::principal_axes(points3d);
+        QVERIFY(center3d == Point3d(0., 0., 0.));
+        QVERIFY((axes3d.values == vector<double, 3>{18. / 5., 8. / 5., 2. / 5.}));
+
+        const std::vector<matrix<double, 3, 3>> matrices{matrix<double, 3, 3>{2., 1., 0., 1., 2., 0., 0., 0., 1.},
+                                                         matrix<double, 3, 3>{1., 0., 0., 0., 1., 0., 0., 0., 1.}};
+        const auto batch = matrix_algo::eigen_symmetric(matrices);
+        QVERIFY(batch.size() == 2);
+        QVERIFY((batch[0].values == vector<double, 3>{3., 1., 1.}));
+        QVERIFY(residual(matrices[0], batch[0]) < 1e-12);
+        QVERIFY(residual(matrices[1], batch[1]) < 1e-12);
+    }
+}
+
+void Unit_Test::test_least_squares()
+{
+    {//Переопределённая система
+        const matrix<double, 4, 2> a{1., 0.,
+                                     1., 1.,
+                                     1., 2.,
+                                     1., 3.};
+        const matrix<double, 4, 1> b{1., 2., 2., 4.};
+        const auto x = matrix_algo::least_squares(a, b);
+        QVERIFY(x.has_value());
+        QVERIFY(algorithm::compare(x->value(0, 0), 0.9) && algorithm::compare(x->value(1, 0), 0.9));
+        const matrix<double, 3, 2> singular{1., 2., 2., 4., 3., 6.};
+        QVERIFY(!matrix_algo::least_squares(singular, matrix<double, 3, 1>{1., 2., 3.}).has_value());
+
+        const auto y = matrix_algo::least_squares<double, 2>({{1., 0.}, {1., 1.}, {1., 2.}, {1., 3.}}, {1., 2., 2., 4.});
+        QVERIFY((y.value() == vector<double, 2>{0.9, 0.9}));
+        bool thrown = false;
+        try{
+            matrix_algo::least_squares<double, 2>({{1., 0.}}, {1., 2.});
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//Нормальные уравнения и QR дают одно решение, обновление по наблюдению
+        std::mt19937 generator(5);
+        std::uniform_real_distribution<double> distribution(-1., 1.);
+        matrix_algo::least_squares_normal<double, 3> normal;
+        matrix_algo::least_squares_qr<double, 3> qr;
+        QVERIFY(!normal.solve().has_value() && !qr.solve().has_value());
+        for(int i = 0; i < 200; ++i){
+            const std::array<double, 3> row{1., distribution(generator), distribution(generator)};
+            const auto value = 0.5 + 2. * row[1] - 3. * row[2] + 0.01 * distribution(generator);
+            normal.add(row, value);
+            qr.add(row, value);
+        }
+        QVERIFY(normal.size() == 200 && qr.size() == 200);
+        const auto x1 = normal.solve().value();
+        const auto x2 = qr.solve().value();
+        QVERIFY(x1 == x2);
+        QVERIFY(algorithm::compare_common(x2.get(0), 0.5, 0.01) && algorithm::compare_common(x2.get(2), -3., 0.01));
+        QVERIFY(algorithm::compare(normal.residual(x1), qr.residual()));
+        //R^T R = A^T A
+        const auto r = qr.r();
+        QVERIFY(algorithm::compare_common((matrix_algo::transposed(r) * r).value(0, 0), 200., 1e-9));
+
+        //Забывание: после смены модели оценка следует за новыми наблюдениями
+        for(int i = 0; i < 200; ++i){
+            const std::array<double, 3> row{1., distribution(generator), distribution(generator)};
+            qr.forget(0.9);
+            normal.forget(0.9);
+            qr.add(row, 1.5 + 2. * row[1] - 3. * row[2]);
+            normal.add(vector<double, 3>{row[0], row[1], row[2]}, 1.5 + 2. * row[1] - 3. * row[2]);
+        }
+        QVERIFY(algorithm::compare_common(qr.solve()->get(0), 1.5, 1e-6));
+        QVERIFY(algorithm::compare_common(normal.solve()->get(0), 1.5, 1e-6));
+        qr.clear();
+        QVERIFY(qr.size() == 0 && !qr.solve().has_value());
+    }
+
+    {//Многочлен
+        std::vector<Point> points;
+        for(int i = 0; i < 20; ++i){
+            points.emplace_back(1.7e9 + i, 3. - 2. * i + 0.5 * i * i);
+        }
+        const auto c = approximation_algo::fit_polynomial<2>(points, 1.7e9);
+        QVERIFY((c.value() == vector<double, 3>{3., -2., 0.5}));
+        QVERIFY(algorithm::compare(approximation_algo::polynomial_value(c.value(), 1.7e9 + 30., 1.7e9), 3. - 60. + 450.));
+        QVERIFY(!approximation_algo::fit_polynomial<2>(std::vector<Point>{Point(0., 1.), Point(1., 2.)}).has_value());
+    }
+
+    {//Окружность
+        const std::vector<Point> exact{Point(3., 2.), Point(1., 4.), Point(-1., 2.), Point(1., 0.)};
+        const auto kasa = approximation_algo::fit_circle_kasa<Circle>(exact);
+        const auto taubin = approximation_algo::fit_circle_taubin<Circle>(exact);
+        QVERIFY((kasa->center() == Point(1., 2.)) && algorithm::compare(kasa->radius(), 2.));
+        QVERIFY((taubin->center() == Point(1., 2.)) && algorithm::compare(taubin->radius(), 2.));
+
+        std::mt19937 generator(3);
+        std::normal_distribution<double> noise(0., 0.05);
+        std::vector<Point> arc;
+        for(int i = 0; i < 50; ++i){
+            const auto angle = 0.3 + 0.8 * i / 49.;
+            arc.emplace_back(100. + 50. * std::sin(angle) + noise(generator), -20. + 50. * std::cos(angle) + noise(generator));
+        }
+        const auto fit = approximation_algo::fit_circle_taubin<Circle>(arc).value();
+        QVERIFY(algorithm::compare_common(fit.radius(), 50., 0.5));
+        QVERIFY(algorithm::compare_common(fit.center().x(), 100., 0.5) && algorithm::compare_common(fit.center().y(), -20., 0.5));
+
+        const std::vector<Point> line{Point(0., 0.), Point(1., 1.), Point(2., 2.)};
+        QVERIFY(!approximation_algo::fit_circle_kasa<Circle>(line).has_value());
+        QVERIFY(!approximation_algo::fit_circle_taubin<Circle>(line).has_value());
+        QVERIFY(!approximation_algo::fit_circle_taubin<Circle>(std::vector<Point>{Point(0., 0.), Point(1., 1.)}).has_value());
+    }
+}
+
+void Unit_Test::test_sparse_matrix()
+{
+    {//Построение и связь с плотными матрицами
+        const matrix<double, 3, 4> dense{4., 1., 0., 0.,
+                                         0., 3., 0., 2.,
+                                         0., 0., 0., 5.};
+        const sparse_matrix<double> m(dense);
+        QVERIFY((m.rows() == 3) && (m.columns() == 4) && (m.non_zeros() == 5));
+        QVERIFY(algorithm::compare(m.value(1, 3), 2.) && algorithm::compare(m.value(2, 0), 0.));
+        QVERIFY((m.to_dense<3, 4>() == dense));
+        QVERIFY((m.transposed().to_dense<4, 3>() == matrix_algo::transposed(dense)));
+        QVERIFY(m.diagonal() == (std::vector<double>{4., 3., 0.}));
+
+        //Повторы суммируются, порядок элементов не важен
+        const sparse_matrix<double> entries(3, 4, {{2, 3, 5.}, {0, 1, 0.5}, {1, 3, 2.}, {0, 0, 4.}, {1, 1, 3.}, {0, 1, 0.5}});
+        QVERIFY((entries.to_dense<3, 4>() == dense));
+        QVERIFY(std::ranges::equal(entries.offsets(), std::vector<size_t>{0, 2, 4, 5}));
+        QVERIFY(std::ranges::equal(entries.column_indices(), std::vector<size_t>{0, 1, 1, 3, 3}));
+
+        bool thrown = false;
+        try{
+            sparse_matrix<double>(2, 2, {{2, 0, 1.}});
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+        thrown = false;
+        try{
+            m.to_dense<4, 4>();
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//Умножение
+        const matrix<double, 3, 4> dense{4., 1., 0., 0.,
+                                         0., 3., 0., 2.,
+                                         0., 0., 0., 5.};
+        const sparse_matrix<double> m(dense);
+        QVERIFY((m * std::vector<double>{1., 2., 3., 4.}) == (std::vector<double>{6., 14., 20.}));
+        QVERIFY((m * vector<double, 4>{1., 2., 3., 4.}) == (std::vector<double>{6., 14., 20.}));
+        std::vector<double> y(4);
+        m.multiply_transposed(std::vector<double>{1., 2., 3.}, y);
+        QVERIFY(y == (std::vector<double>{4., 7., 0., 19.}));
+        const matrix<double, 4, 2> x{1., 0.,
+                                     0., 1.,
+                                     1., 1.,
+                                     2., -1.};
+        QVERIFY((m * x) == (std::vector<double>{4., 1., 4., 1., 10., -5.}));
+
+        bool thrown = false;
+        try{
+            m * std::vector<double>{1., 2.};
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+
+        //Параллельное умножение совпадает с последовательным
+        std::mt19937 generator(11);
+        std::uniform_int_distribution<size_t> column(0, 999);
+        std::uniform_real_distribution<double> value(-1., 1.);
+        std::vector<sparse_entry<double>> entries;
+        for(size_t i = 0; i < 5000; ++i){
+            for(size_t k = 0; k < 1 + i % 7; ++k){
+                entries.push_back({i, column(generator), value(generator)});
+            }
+        }
+        const sparse_matrix<double> big(5000, 1000, entries);
+        std::vector<double> in(1000);
+        for(auto &item : in){
+            item = value(generator);
+        }
+        std::vector<double> serial(5000);
+        std::vector<double> parallel(5000);
+        big.multiply(std::span<const double>(in), std::span(serial));
+        big.multiply(std::span<const double>(in), std::span(parallel), 4, 100);
+        QVERIFY(serial == parallel);
+    }
+
+    {//Сопряжённые градиенты: уравнение Пуассона на сетке
+        const size_t size = 30;
+        const size_t n = size * size;
+        std::vector<sparse_entry<double>> entries;
+        for(size_t i = 0; i < size; ++i){
+            for(size_t j = 0; j < size; ++j){
+                const auto k = i * size + j;
+                entries.push_back({k, k, 4.});
+                if(i > 0) entries.push_back({k, k - size, -1.});
+                if(i + 1 < size) entries.push_back({k, k + size, -1.});
+                if(j > 0) entries.push_back({k, k - 1, -1.});
+                if(j + 1 < size) entries.push_back({k, k + 1, -1.});
+            }
+        }
+        const sparse_matrix<double> m(n, n, entries);
+        const std::vector<double> b(n, 1.);
+        std::vector<double> x(n);
+        const auto result = matrix_algo::conjugate_gradient(m, std::span<const double>(b), std::span(x), 1e-10, 0, 2);
+        QVERIFY(result.converged && (result.iterations < n));
+        const auto check = m * x;
+        QVERIFY(std::ranges::equal(check, b, [](double a, double c){
+            return algorithm::compare(a, c);
+        }));
+
+        const auto small = matrix_algo::conjugate_gradient(sparse_matrix<double>(matrix<double, 2, 2>{4., 1., 1., 3.}), std::vector<double>{1., 2.});
+        QVERIFY(algorithm::compare(small[0], 1. / 11.) && algorithm::compare(small[1], 7. / 11.));
+
+        bool thrown = false;
+        try{
+            matrix_algo::conjugate_gradient(sparse_matrix<double>(matrix<double, 2, 2>{1., 2., 2., 1.}), std::vector<double>{1., -1.});
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+
+    {//LSQR
+        const matrix<double, 4, 2> a{1., 0.,
+                                     1., 1.,
+                                     1., 2.,
+                                     1., 3.};
+        const auto x = matrix_algo::lsqr(sparse_matrix<double>(a), std::vector<double>{1., 2., 2., 4.});
+        QVERIFY(algorithm::compare(x[0], 0.9) && algorithm::compare(x[1], 0.9));
+
+        //Нивелирная сеть: превышения между пунктами и опорные высоты
+        std::mt19937 generator(1);
+        std::uniform_int_distribution<size_t> point(0, 499);
+        std::normal_distribution<double> noise(0., 0.001);
+        std::vector<double> heights(500);
+        for(auto &height : heights){
+            height = 100. * noise(generator) * 1000.;
+        }
+        std::vector<sparse_entry<double>> entries;
+        std::vector<double> observations;
+        for(size_t i = 0; i < 500; i += 50){
+            entries.push_back({observations.size(), i, 1.});
+            observations.push_back(heights[i]);
+        }
+        for(size_t k = 0; k < 5000; ++k){
+            const auto i = point(generator);
+            const auto j = (i + 1 + point(generator) % 499) % 500;
+            entries.push_back({observations.size(), i, 1.});
+            entries.push_back({observations.size(), j, -1.});
+            observations.push_back(heights[i] - heights[j] + noise(generator));
+        }
+        const sparse_matrix<double> m(observations.size(), 500, entries);
+        std::vector<double> estimate(500);
+        const auto result = matrix_algo::lsqr(m, std::span<const double>(observations), std::span(estimate), 1e-12);
+        QVERIFY(result.converged);
+        double error = 0.;
+        for(size_t i = 0; i < 500; ++i){
+            error = std::max(error, std::abs(estimate[i] - heights[i]));
+        }
+        QVERIFY(error < 0.005);
+    }
+}
+
+void Unit_Test::test_matrix_iterator()
+{
+    using m34 = matrix<double, 3, 4>;
+    static_assert(std::contiguous_iterator<m34::iterator>);
+    static_assert(std::contiguous_iterator<m34::const_iterator>);
+    static_assert(std::contiguous_iterator<m34::iterator_column>);
+    static_assert(std::random_access_iterator<m34::iterator_row>);
+    static_assert(std::random_access_iterator<m34::const_iterator_row>);
+    static_assert(!std::contiguous_iterator<m34::iterator_row>);
+    static_assert(std::ranges::contiguous_range<m34>);
+    static_assert(std::ranges::sized_range<const m34>);
+    static_assert(std::is_trivially_copyable_v<m34::iterator>);
+    static_assert(std::is_same_v<std::iter_value_t<m34::const_iterator>, double>);
+    static_assert(std::is_convertible_v<m34::iterator, m34::const_iterator>);
+
+    m34 m{ 1.,  2.,  3.,  4.,
+           5.,  6.,  7.,  8.,
+           9., 10., 11., 12.};
+    {//Сплошной обход
+        auto it = m.begin();
+        QVERIFY(std::to_address(it) == &m.value(0, 0));
+        QVERIFY((it + 5 == std::next(m.begin(), 5)) && (5 + it == it + 5));
+        QVERIFY((m.end() - m.begin() == 12) && (m.end() - 12 == m.begin()));
+        QVERIFY(algorithm::compare(it[6], 7.));
+        it += 7;
+        it -= 2;
+        QVERIFY(algorithm::compare(*it, 6.) && (it > m.begin()) && (it <= m.end()));
+        m34::const_iterator cit = it;
+        QVERIFY(cit == std::as_const(m).begin() + 5);
+        QVERIFY(std::ranges::size(m) == 12);
+    }
+    {//Обход столбца с шагом строки
+        auto it = m.begin_row(1);
+        QVERIFY((m.end_row(1) - it == 3) && algorithm::compare(it[2], 10.));
+        it += 2;
+        it -= 1;
+        QVERIFY(algorithm::compare(*it, 6.));
+        QVERIFY(algorithm::compare(*(it - 1), 2.) && algorithm::compare(*(1 + it), 10.));
+        QVERIFY(std::ranges::equal(std::ranges::subrange(m.begin_row(3), m.end_row(3)) | std::views::reverse,
+                                   std::array{12., 8., 4.}));
+    }
+    {//Обход строки
+        auto it = m.begin_column(2);
+        QVERIFY((m.end_column(2) - it == 4) && (std::to_address(it) == &m.value(2, 0)));
+        it += 3;
+        it -= 1;
+        QVERIFY(algorithm::compare(*it, 11.) && algorithm::compare(it[-2], 9.));
+    }
+    {//Алгоритмы стандартной библиотеки над матрицей
+        m34 copy;
+        std::ranges::copy(m, copy.begin());
+        QVERIFY(copy == m);
+        std::ranges::fill(copy, 2.);
+        QVERIFY(std::ranges::all_of(copy, [](auto item){ return algorithm::compare(item, 2.); }));
+        std::ranges::transform(m, copy, copy.begin(), std::plus{});
+        QVERIFY(algorithm::compare(copy.value(2, 3), 14.));
+        QVERIFY((m + m == 2. * m) && (m - m == m34{}));
+        std::ranges::sort(copy.begin_row(0), copy.end_row(0), std::greater{});
+        QVERIFY(algorithm::compare(copy.value(0, 0), 11.) && algorithm::compare(copy.value(2, 0), 3.));
+    }
+}
+
+void Unit_Test::test_matrix_view()
+{
+    const matrix<double, 2, 3> a{1., 2., 3.,
+                                 4., 5., 6.};
+    const matrix<double, 3, 2> b{7.,  8.,
+                                 9., 10.,
+                                11., 12.};
+    {//Представление agl::matrix
+        matrix<double, 2, 3> m = a;
+        auto view = m.view();
+        static_assert(decltype(view)::static_rows == 2 && decltype(view)::static_columns == 3);
+        QVERIFY((view.rows() == 2) && (view.columns() == 3) && (view.stride(0) == 3) && (view.stride(1) == 1));
+        QVERIFY(view.is_contiguous() && (view.data() == &m.value(0, 0)));
+        view(1, 2) = 60.;
+        QVERIFY(algorithm::compare(m.value(1, 2), 60.));
+        QVERIFY(std::ranges::equal(view.row(0), std::array{1., 2., 3.}));
+        matrix_view<const double> dynamic = a.view();
+        QVERIFY((dynamic.rows() == 2) && algorithm::compare(dynamic(1, 0), 4.));
+
+        bool thrown = false;
+        try{
+            dynamic.value(2, 0);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+    {//Умножение без копирования, результат совпадает с agl::matrix
+        matrix<double, 2, 2> out;
+        matrix_algo::mul(a.view(), b.view(), out.view());
+        QVERIFY(out == a * b);
+
+        //Внешние буферы с разной раскладкой: b хранится по столбцам
+        std::vector<double> a_rows{1., 2., 3., 4., 5., 6.};
+        std::vector<double> b_columns{7., 9., 11., 8., 10., 12.};
+        std::vector<double> result(4);
+        matrix_algo::mul(matrix_view(std::span(a_rows), 2, 3),
+                         matrix_view<double, std::dynamic_extent, std::dynamic_extent, layout_left>(b_columns.data(), 3, 2),
+                         matrix_view(std::span(result), 2, 2));
+        QVERIFY(matrix_view<const double>(result.data(), 2, 2)(1, 1) == (a * b).value(1, 1));
+
+        std::vector<double> x{1., 0., -1.};
+        std::vector<double> y(2);
+        matrix_algo::mul(a.view(), std::span<const double>(x), std::span(y));
+        QVERIFY(y == (std::vector<double>{-2., -2.}));
+
+        bool thrown = false;
+        try{
+            matrix_algo::mul(matrix_view(std::span(a_rows), 2, 3), matrix_view(std::span(a_rows), 2, 3), matrix_view(std::span(result), 2, 2));
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+        thrown = false;
+        try{
+            (void)matrix_view(std::span(result), 3, 3);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+        //Результат поверх исходных данных
+        thrown = false;
+        try{
+            std::vector<double> square{1., 2., 3., 4.};
+            const matrix_view view(std::span<double>(square), 2, 2);
+            matrix_algo::mul(view, view, view);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+    {//Транспонирование и подматрицы без копирования
+        const auto t = matrix_algo::transposed(a.view());
+        static_assert(std::is_same_v<decltype(t)::layout_type, layout_left>);
+        QVERIFY((t.rows() == 3) && (t.columns() == 2) && (t.data() == a.view().data()));
+        matrix<double, 3, 2> copy;
+        matrix_algo::copy(t, copy.view());
+        QVERIFY(copy == a.transposed());
+
+        const auto sub = a.view().submatrix(0, 1, 2, 2);
+        QVERIFY((sub.rows() == 2) && !sub.is_contiguous() && algorithm::compare(sub(1, 1), 6.));
+        QVERIFY(algorithm::compare(sub.transposed()(1, 0), 3.));
+        QVERIFY(algorithm::compare(matrix_algo::determinant(sub), 2. * 6. - 3. * 5.));
+
+        //Чередующиеся каналы: каждый второй элемент буфера
+        std::vector<double> interleaved{1., -1., 2., -1., 3., -1., 4., -1.};
+        matrix_view<double, 2, 2, layout_stride> channel(interleaved.data(), 2, 2, {4, 2});
+        QVERIFY(algorithm::compare(matrix_algo::determinant(channel), -2.));
+
+        //Произведение двух каналов пишется в третий канал того же буфера
+        std::vector<double> rgb{1., 5., 0., 2., 6., 0., 3., 7., 0., 4., 8., 0.};
+        using channel_view = matrix_view<double, std::dynamic_extent, std::dynamic_extent, layout_stride>;
+        const channel_view red(rgb.data(), 2, 2, {6, 3});
+        const channel_view green(rgb.data() + 1, 2, 2, {6, 3});
+        const channel_view blue(rgb.data() + 2, 2, 2, {6, 3});
+        matrix_algo::mul(red, green, blue);
+        QVERIFY((blue(0, 0) == 1. * 5. + 2. * 7.) && (blue(1, 1) == 3. * 6. + 4. * 8.));
+        QVERIFY((red(1, 1) == 4.) && (green(1, 1) == 8.));
+
+        //Канал, совпадающий с входом хотя бы в одном элементе, по-прежнему запрещён
+        bool thrown = false;
+        try{
+            matrix_algo::mul(red, green, channel_view(rgb.data() + 2, 2, 2, {6, 1}));
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+    {//Определитель и параллельное умножение большой матрицы
+        matrix<double, 6, 6> m;
+        std::ranges::generate(m, [i = 0]() mutable{
+            ++i;
+            return (i % 7) + ((i % 8 == 1) ? 10. : 0.);
+        });
+        QVERIFY(algorithm::compare_common(matrix_algo::determinant(m.view()), m.determinant(), 1e-6 * std::abs(m.determinant())));
+        QVERIFY(algorithm::compare(matrix_algo::determinant(matrix<double, 3, 3>{2., 0., 0., 0., 3., 0., 0., 0., 4.}.view()), 24.));
+
+        const size_t n = 150;
+        std::vector<double> left(n * n), right(n * n), serial(n * n), parallel(n * n);
+        for(size_t i = 0; i < n * n; ++i){
+            left[i] = std::sin(double(i));
+            right[i] = std::cos(double(i) * 0.5);
+        }
+        matrix_algo::mul(matrix_view(std::span(left), n, n), matrix_view(std::span(right), n, n), matrix_view(std::span(serial), n, n));
+        matrix_algo::mul(matrix_view(std::span(left), n, n), matrix_view(std::span(right), n, n), matrix_view(std::span(parallel), n, n), 4, 16);
+        QVERIFY(serial == parallel);
+        double expected = 0;
+        for(size_t k = 0; k < n; ++k){
+            expected += left[17 * n + k] * right[k * n + 42];
+        }
+        QVERIFY(algorithm::compare(serial[17 * n + 42], expected));
+    }
+    {//dynamic_matrix
+        dynamic_matrix<double> m(2, 3);
+        matrix_algo::copy(a.view(), m.view());
+        QVERIFY(algorithm::compare(m.value(1, 2), 6.) && (m.view().rows() == 2));
+    }
+}
+
+void Unit_Test::test_matrix_into()
+{
+    const matrix<double, 2, 3> a{1., 2., 3.,
+                                 4., 5., 6.};
+    const matrix<double, 3, 2> b{7.,  8.,
+                                 9., 10.,
+                                11., 12.};
+    {//Запись в существующие матрицы
+        matrix<double, 2, 2> product(uninitialized);
+        matrix_algo::mul_into(a, b, product);
+        QVERIFY((product == matrix<double, 2, 2>{58., 64., 139., 154.}));
+        QVERIFY(product == a * b);
+
+        matrix<double, 3, 2> t(uninitialized);
+        matrix_algo::transpose_into(a, t);
+        QVERIFY(t == a.transposed());
+
+        matrix<double, 3, 3> square{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+        const auto expected = square.transposed();
+        matrix_algo::transpose_into(square, square);
+        QVERIFY(square == expected);
+
+        matrix<double, 2, 3> sum = a;
+        matrix_algo::add_into(sum, a, sum);
+        QVERIFY(sum == 2. * a);
+        matrix_algo::sub_into(sum, a, sum);
+        QVERIFY(sum == a);
+
+        bool thrown = false;
+        try{
+            matrix<double, 2, 2> m{1., 2., 3., 4.};
+            matrix_algo::mul_into(m, m, m);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+
+        const matrix<double, 2, 2> rotation{0., -1., 1., 0.};
+        vector<double, 2> v(uninitialized);
+        matrix_algo::mul_into(rotation, vector<double, 2>{1., 2.}, v);
+        QVERIFY((v == vector<double, 2>{-2., 1.}));
+    }
+    {//Строки и столбцы без копирования
+        matrix<double, 2, 3> m = a;
+        QVERIFY(m.data() == &m.value(0, 0));
+        auto row = m.row_view(1);
+        static_assert(decltype(row)::extent == 3);
+        row[2] = 60.;
+        QVERIFY(algorithm::compare(m.value(1, 2), 60.));
+        auto column = m.column_view(1);
+        QVERIFY((std::ranges::size(column) == 2) && algorithm::compare(column[1], 5.));
+        std::ranges::fill(column, 0.);
+        QVERIFY(algorithm::compare(m.value(0, 1), 0.) && algorithm::compare(m.value(1, 1), 0.));
+        QVERIFY(std::ranges::equal(a.row_view(0), a.row(0)) && std::ranges::equal(a.column_view(2), a.column(2)));
+
+        bool thrown = false;
+        try{
+            a.column_view(3);
+        }
+        catch(const std::logic_error &){
+            thrown = true;
+        }
+        QVERIFY(thrown);
+    }
+}
+
+namespace {
+
+matrix<double, 64, 64> benchmark_matrix(double shift)
+{
+    matrix<double, 64, 64> m;
+    std::ranges::generate(m, [i = shift]() mutable{
+        return i += 0.25;
+    });
+    return m;
+}
+
+}
+
+void Unit_Test::benchmark_matrix_copy()
+{
+    const auto m1 = benchmark_matrix(0.);
+    matrix<double, 64, 64> m2;
+    QBENCHMARK{
+        std::ranges::copy(m1, m2.begin());
+    }
+    QVERIFY(m1 == m2);
+}
+
+void Unit_Test::benchmark_matrix_transform()
+{
+    const auto m1 = benchmark_matrix(0.);
+    const auto m2 = benchmark_matrix(1.);
+    matrix<double, 64, 64> m3;
+    QBENCHMARK{
+        m3 = m1 + m2;
+    }
+    QVERIFY(algorithm::compare(m3.value(63, 63), m1.value(63, 63) * 2 + 1));
+}
+
+void Unit_Test::benchmark_matrix_mul()
+{
+    const auto m1 = benchmark_matrix(0.);
+    const auto m2 = matrix_algo::identity_matrix<matrix, double, 64>();
+    matrix<double, 64, 64> m3;
+    QBENCHMARK{
+        m3 = m1 * m2;
+    }
+    QVERIFY(m3 == m1);
+}
+
+void Unit_Test::benchmark_matrix_mul_into()
+{
+    //Шаг фильтра Калмана P = F P F^T + Q без временных матриц
+    const matrix<double, 4, 4> f{1., 0., 0.1, 0.,
+                                 0., 1., 0., 0.1,
+                                 0., 0., 1., 0.,
+                                 0., 0., 0., 1.};
+    const auto ft = f.transposed();
+    const auto q = 0.01 * matrix_algo::identity_matrix<matrix, double, 4>();
+    auto p = matrix_algo::identity_matrix<matrix, double, 4>();
+    matrix<double, 4, 4> fp(uninitialized);
+    QBENCHMARK{
+        matrix_algo::mul_into(f, p, fp);
+        matrix_algo::mul_into(fp, ft, p);
+        matrix_algo::add_into(p, q, p);
+    }
+    QVERIFY(p.value(0, 0) > 1.);
 }
 
 void Unit_Test::test_vector()
@@ -25,11 +25,30 @@ private slots:
     void test_polygon();
     void test_polygon_algorithm();
 
+    void test_polyline();
+    void test_simplification();
+    void test_track();
+    void test_cpa();
+
     void test_geo_algorithm();
+    void test_geo_index();
+    void test_projection();
 
     void test_approximation();
 
     void test_matrix();
+    void test_affine();
+    void test_quaternion();
+    void test_eigen();
+    void test_least_squares();
+    void test_sparse_matrix();
+    void test_matrix_iterator();
+    void test_matrix_view();
+    void test_matrix_into();
+    void benchmark_matrix_copy();
+    void benchmark_matrix_transform();
+    void benchmark_matrix_mul();
+    void benchmark_matrix_mul_into();
     void test_vector();
 };
 
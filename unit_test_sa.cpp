@@ -548,4 +548,13 @@ void Unit_Test_SA::test_figure_route(){
         }
     }
 
+    {//route_polyline
+        auto figures = sa::itinerary_stage(agl::Point(300, 100), agl::Point(300, 200), agl::Point(100, 300), 100);
+        auto polyline = sa::route_polyline(figures);
+        QVERIFY(polyline.count() == 2);
+        QVERIFY(agl::algorithm::compare(polyline.length(), 100. + 50. * agl::algorithm::pi<double>));
+        QVERIFY(polyline.point_at(0.).value() == agl::Point(300, 200));
+        QVERIFY(polyline.point_at(50. * agl::algorithm::pi<double>).value() == agl::Point(200, 300));
+        QVERIFY(polyline.point_at(polyline.length()).value() == agl::Point(100, 300));
+    }
 }
@@ -1,11 +1,15 @@
 #ifndef USER_TYPE_H
 #define USER_TYPE_H
 
+#include "structs/affine_impl.h"
 #include "structs/circle_impl.h"
 #include "structs/line_impl.h"
 #include "structs/point_impl.h"
+#include "structs/point_cloud_impl.h"
 #include "unit/angle.h"
 #include "structs/polygon_impl.h"
+#include "structs/polyline_impl.h"
+#include "structs/quaternion_impl.h"
 #include "structs/struct_geo_imp.h"
 
 namespace agl{
@@ -14,7 +18,9 @@ using Lenght = double;
 using Angle = angle_impl<double>;
 using Point = point2d_impl<double>;
 using Point3d = point3d_impl<double>;
-using Point4d = point4d_abstract<double, double, double, double>;
+using Point4d = point4d_impl<double>;
+using PointCloud = point_cloud2d_impl<double>;
+using PointCloud3d = point_cloud3d_impl<double>;
 
 using Polar2d = polar2d_impl<double, Angle>;
 using Polar3d = Polar3d_Impl<double, Angle, double>;
@@ -26,6 +32,8 @@ using LineSection = line_section_impl<Point>;
 using Circle = circle_impl<double, Point>;
 using Arc = arc_impl<double, Point, Angle>;
 
+using Polyline = polyline_impl<Point, Arc>;
+
 
 using ConvexPolygon = convex_polygone_impl<Point>;
 using Rectangle = rectangle_impl<double, Point>;
@@ -33,7 +41,12 @@ using Square = square_impl<double, Point>;
 using Triangle = triangle_impl<double, Point>;
 using RegularPolygon = regular_polygon_impl<double, Point>;
 
+using Affine2d = affine_impl<double, 2>;
+using Affine3d = affine_impl<double, 3>;
+using Quaternion = quaternion_impl<double>;
+
 using PointGeo = point_geo2d_impl<double, Angle>;
+using PointGeoPrepared = point_geo2d_prepared<double, Angle>;
 using PointGeo3d = point_geo3d_abstract<Angle, Angle, double>;
 using PointGeo4d = PointGeo4d_Impl<Angle, Angle, double, double>;
 